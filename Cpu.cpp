@@ -4,25 +4,68 @@
 #include <sstream>
 #include <vector>
 #include <deque>
+#include <map>
+#include <set>
+#include <queue>
+#include <climits>
 #include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cerrno>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <random>
+#include <csignal>
+#include <chrono>
+#include <ctime>
+#include <unistd.h>
+#include <glob.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 using namespace std;
 
-#define NUM_ALGORITHMS 5
+#define NUM_ALGORITHMS 8
+#define MAX_MLFQ_LEVELS 32
+#define NICE_0_LOAD 1024
+#define WINDOW_RING 16
+#define WAITING_BUCKETS 448
 
-const string ALGORITHM[NUM_ALGORITHMS] = {"FCFS", "NPSJF", "PSJF", "RR", "RRP"};
+const string ALGORITHM[NUM_ALGORITHMS] = {"FCFS", "NPSJF", "PSJF", "RR", "RRP", "CFS", "MLFQ", "EDF"};
 
 enum algorithm {
-	FCFS, NPSJF, PSJF, RR, RRP
+	FCFS, NPSJF, PSJF, RR, RRP, CFS, MLFQ, EDF
+};
+
+//CFS load weight of each nice value from -20 to 19 (as in the Linux kernel)
+const int NICE_WEIGHT[40] = {
+	88761, 71755, 56483, 46273, 36291,
+	29154, 23254, 18705, 14949, 11916,
+	 9548,  7620,  6100,  4904,  3906,
+	 3121,  2501,  1991,  1586,  1277,
+	 1024,   820,   655,   526,   423,
+	  335,   272,   215,   172,   137,
+	  110,    87,    70,    56,    45,
+	   36,    29,    23,    18,    15
 };
 
 typedef struct {
 	int arrival;		//arrival time
-	int burst;			//cpu burst length
+	int burst;			//cpu burst length (the current cpu burst if the process does i/o)
+	int nice;			//nice value from -20 to 19 (CFS only)
+	int deadline;		//time after arrival by which the process should finish, 0 if none
+	int io;				//index in the workload's i/o table of the process' next i/o burst, 0 if it has none
 } process;
 
 typedef struct {
 	int waiting;
 	int turnAround;
+	int deadline;		//the process' deadline, so that misses can be counted
 } processStats;
 
 //process block
@@ -35,96 +78,529 @@ typedef struct {
 //cpu scheduling options
 typedef struct {
 	algorithm alg;
-	int slice;			//length of time slice
+	int slice;			//length of time slice (top level quantum for MLFQ)
 	int prioritySlice;  //lengh of priority time slice (RRP only)
 	int switchTime;		//time it takes to perform a contet switch
+	int latency;		//targeted period in which every runnable process runs once (CFS only)
+	int granularity;	//minimum time slice, also the wakeup preemption threshold (CFS only)
+	int levels;			//number of priority levels, the quantum doubles at each lower level (MLFQ only)
+	int boostPeriod;	//time between moving every process back to the top level, 0 for never (MLFQ only)
 } option;
 
-void fcfs(vector<process> ps, int & totalTime, int & idleTime, vector<processStats> & pStats);
-void npsjf(vector<process> ps, int & totalTime, int & idleTime, vector<processStats> & pStats);
-void psjf(vector<process> ps, int & totalTime, int & idleTime, vector<processStats> & pStats);
-void rr(vector<process> ps, int slice, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats);
-void rrp(vector<process> ps, int slice, int prioritySlice, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats);
+//job held by a lockstep lane
+//		-- useage: the process is identified by its index in the arrival sorted process vector
+typedef struct {
+	int index;
+	int remaining;		//cpu burst left to run
+} laneJob;
+
+//CFS scheduling entity
+//		-- useage: vruntime is kept in 1/65536ths of a time unit so heavy weights still advance it
+typedef struct {
+	processBlock b;
+	int burst;				//original cpu and i/o burst length (see serviceTime)
+	int weight;
+	long long vruntime;		//weighted time spent on the cpu
+} cfsEntity;
+
+//MLFQ process block
+//		-- useage: a processBlock together with its priority level and the time it has used at that level
+typedef struct {
+	processBlock b;
+	int burst;			//original cpu and i/o burst length (see serviceTime)
+	int level;
+	long long used;
+} mlfqBlock;
+
+//workload
+//		-- useage: processes together with the i/o table their i/o bursts are kept in, loaded and freed as one.
+//		   The table holds each process' bursts after its first cpu burst, alternating i/o and cpu and ended by
+//		   a 0, so that processes stay small plain values the schedulers can copy every time unit
+typedef struct {
+	vector<process> ps;
+	vector<int> ioTable;
+} workload;
+
+//timer heap of processes blocked on i/o
+//		-- useage: entries are ((wake time, time blocked), process); the process waking first is on top, and
+//		   processes waking at the same time leave in the order they blocked (only one process can block at a time)
+struct wakesLater {
+	template<typename T> bool operator()(const T & a, const T & b) const { return a.first>b.first; }
+};
+template<typename T> using timerHeap = priority_queue< pair< pair<long long,long long>, T >, vector< pair< pair<long long,long long>, T > >, wakesLater >;
+
+//summary of a single simulated cpu scheduling option
+typedef struct {
+	double avgTurnAround;
+	double avgWaiting;
+	double p99Waiting;
+	double cpuUtilization;	//percent
+	int deadlineMisses;
+} optionSummary;
+
+//quantity minimized by the slice optimizer
+enum objective {
+	TURNAROUND, P99WAITING, UTILIZATION
+};
+
+//slice optimizer settings and search state
+//		-- useage: results are cached by slice/prioritySlice so no configuration is simulated twice
+typedef struct {
+	algorithm alg;				//RR or RRP
+	int switchTime;				//context switch time shared by every candidate
+	objective goal;
+	double utilizationFloor;	//minimum cpu utilization % (UTILIZATION only)
+	int maxSlice;				//upper bound of the search range (longest burst)
+	map< pair<int,int>, double > scores;
+	int simulations;
+} optimizer;
+
+//steady state run settings (--steady)
+typedef struct {
+	double meanInterarrival;	//mean time between arrivals (exponentially distributed)
+	double meanBurst;			//mean cpu burst (exponentially distributed)
+	double tolerance;			//stop once the confidence interval half width is at most this fraction of the mean
+	unsigned int seed;
+	int maxJobs;				//give up on converging after this many processes
+} steadySettings;
+
+//steady state estimate of one option
+typedef struct {
+	double mean;				//mean turnaround time after the warm-up
+	double halfWidth;			//half width of the 95% confidence interval of the mean
+	double meanWaiting;			//mean waiting time after the warm-up
+	int warmUp;					//processes discarded as the warm-up transient
+	int jobs;					//processes simulated
+	double load;				//expected fraction of the time the cpu is busy, context switches included
+	bool converged;
+} steadyEstimate;
+
+//synthetic workload generator (--steady)
+//		-- useage: draws one process at a time, so that a run can be extended without generating it again
+typedef struct {
+	mt19937 random;
+	exponential_distribution<double> interarrival;
+	exponential_distribution<double> burst;
+	double arrival;				//arrival time of the next process
+} workloadGenerator;
+
+//metrics of one window of simulated time (--windows)
+typedef struct {
+	long long index;			//the window covers [index*length, (index+1)*length)
+	long long covered;			//simulated time recorded in the window so far
+	long long busyTime;			//time the cpu spent running processes
+	long long readyArea;		//ready queue length summed over time
+	int completions;
+	long long totalWaiting;		//waiting time of the processes that finished in the window
+	int waitingHistogram[WAITING_BUCKETS];	//finished processes by waiting time (see waitingBucket)
+} windowStats;
+
+//windowed metrics recorder
+//		-- useage: the most recent windows are kept in a fixed size ring buffer; the oldest window is
+//		   written out when a new one needs its slot, and the rest by flushWindows at the end of the simulation
+typedef struct {
+	long long length;			//window length in simulated time
+	windowStats ring[WINDOW_RING];
+	int first;					//slot of the oldest window kept
+	int count;					//number of windows kept
+	ostream * out;
+} windowRecorder;
+
+//time and memory used by one phase of a run (--profile)
+typedef struct {
+	string name;
+	chrono::steady_clock::time_point wallStart;
+	double cpuStart;			//seconds of cpu time used by the process when the phase began
+	double wallTime;			//seconds
+	double cpuTime;				//seconds, summed over all threads
+	long peakMemory;			//kilobytes, the phase's own peak resident memory, or how much it raised the process' peak if !ownPeak
+	long memoryStart;			//kilobytes, high-water mark of the process when the phase began
+	bool ownPeak;				//the high-water mark was started over for the phase (Linux only)
+	double simulatedTime;		//time units simulated, 0 if the phase is not a simulation
+	double jobs;				//processes simulated
+} phaseProfile;
+
+//parsed JSON value (server requests)
+//		-- useage: numbers, true, false and null are kept as their text, like strings
+struct jsonValue {
+	char type;		//'s' string, 'n' number or literal, 'a' array, 'o' object
+	string text;
+	vector<jsonValue> items;
+	map<string, jsonValue> fields;
+};
+
+//server client connection
+//		-- useage: shared by the thread reading its requests and the tasks answering them, closed when the last one finishes
+struct serverConnection {
+	int fd;
+	mutex writeLock;	//keeps the lines written by different workers whole
+	~serverConnection() { close(fd); }
+};
+
+//server simulation task: one option of a request
+typedef struct {
+	shared_ptr<serverConnection> conn;
+	shared_ptr<const workload> w;
+	option opt;
+	string id;							//request id echoed in every response
+	shared_ptr< atomic<int> > remaining;	//options of the request still to finish
+	int options;						//options in the request
+} simTask;
+
+//simulation server state
+//		-- useage: shared by serve, the workers and the client threads, which may outlive serve
+typedef struct {
+	map< string, shared_ptr<const workload> > workloads;
+	mutex workloadLock;
+	deque<simTask> tasks;
+	mutex taskLock;
+	condition_variable taskReady;
+	bool stopping;		//set by a shutdown request; no more tasks are queued after it
+	int listenFd;		//closed and set to -1 by serve under taskLock
+} simServer;
+
+//batch run state (--batch)
+//		-- useage: loader threads claim files by index and queue their processes for the simulator threads;
+//		   'loaded' holds at most 'capacity' traces so the loaders never get far ahead of the simulators
+typedef struct {
+	vector<string> files;
+	atomic<int> nextFile;		//index of the next file to load
+	deque< pair< int, shared_ptr<const workload> > > loaded;	//(file index, processes) waiting to be simulated
+	int capacity;
+	int loaders;				//loader threads still running
+	mutex lock;
+	condition_variable traceReady;
+	condition_variable spaceReady;
+	vector< vector<optionSummary> > results;	//by file, then option; empty if the file was skipped
+	vector<string> errors;		//by file; empty if the file was loaded
+	vector<char> deadlines;		//by file; true if some process has a deadline (not vector<bool>: threads set different files at once)
+} batchRun;
+
+void fcfs(vector<process> ps, const vector<int> & ioTable, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows = NULL);
+void npsjf(vector<process> ps, const vector<int> & ioTable, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows = NULL);
+void psjf(vector<process> ps, const vector<int> & ioTable, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows = NULL);
+void rr(vector<process> ps, const vector<int> & ioTable, int slice, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows = NULL);
+void rrp(vector<process> ps, const vector<int> & ioTable, int slice, int prioritySlice, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows = NULL);
+void cfs(vector<process> ps, const vector<int> & ioTable, int latency, int granularity, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows = NULL);
+void mlfq(vector<process> ps, const vector<int> & ioTable, int levels, int quantum, int boostPeriod, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows = NULL);
+void edf(vector<process> ps, const vector<int> & ioTable, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows = NULL);
+void rrLockstep(const vector<process> & ps, const vector<option> & opts, vector<int> & totalTimes, vector<int> & idleTimes, vector< vector<processStats> > & pStats);
+void simulateSplit(const vector<process> & ps, const vector<int> & ioTable, const option & opt, int threads, int & totalTime, int & idleTime, vector<processStats> & pStats);
+bool findBusyPeriods(const vector<process> & ps, const option & opt, vector<int> & starts);
+long long swapsIn(int burst, const option & opt);
+void recordSpan(windowRecorder * windows, long long start, long long length, bool busy, int readyLength);
+void recordCompletion(windowRecorder * windows, long long time, int waiting);
+windowStats & currentWindow(windowRecorder * windows, long long index);
+void writeWindow(windowRecorder * windows, const windowStats & win);
+void flushWindows(windowRecorder * windows);
+void startWindows(windowRecorder * windows, const string & title);
+int waitingBucket(int waiting);
 void addProcessByArrival(process & p,  vector<process> & ps);
 void addProcessBlockByBurst(processBlock & b, deque<processBlock> & bs);
+processBlock newProcessBlock(const process & p);
 void addNewArrivals(vector<process> & ps, deque<processBlock> & ready);
 void addNewArrivalsInOrder(vector<process> & ps, deque<processBlock> & ready);
+bool startIo(process & p, const vector<int> & ioTable, int & ioBurst);
+int serviceTime(const process & p, const vector<int> & ioTable);
+bool blockOnIo(processBlock & b, const vector<int> & ioTable, long long time, timerHeap<processBlock> & blocked);
+void addWakeUps(timerHeap<processBlock> & blocked, long long time, deque<processBlock> & ready);
+void addWakeUpsInOrder(timerHeap<processBlock> & blocked, long long time, deque<processBlock> & ready);
+long long nextEvent(const vector<process> & ps, const timerHeap<processBlock> & blocked);
+bool hasIo(const vector<process> & ps);
+void simulate(const vector<process> & ps, const vector<int> & ioTable, const option & opt, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows = NULL);
+string optionName(const option & opt);
+optionSummary summarize(const vector<processStats> & pStats, int totalTime, int idleTime);
+double percentile(vector<int> values, double fraction);
+void optimize(const vector<process> & ps, const vector<int> & ioTable, optimizer & o);
+double score(const vector<process> & ps, const vector<int> & ioTable, optimizer & o, int slice, int prioritySlice);
+int goldenSectionSearch(const vector<process> & ps, const vector<int> & ioTable, optimizer & o, int lo, int hi, int slice, int prioritySlice, bool searchPriority);
+void readInOptimizer(int argc, char *argv[], const vector<process> & ps, const vector<int> & ioTable, optimizer & o);
+steadyEstimate steadyState(const option & opt, const steadySettings & settings);
+double steadyLoad(const option & opt, const steadySettings & settings);
+void startGenerator(workloadGenerator & g, const steadySettings & settings);
+long long generateProcess(workloadGenerator & g, int & burst);
+int mser5(const vector<double> & values);
+void batchMeans(const vector<double> & values, int from, double & mean, double & halfWidth);
+void printSteadyReport(const vector<option> & opts, const vector<steadyEstimate> & estimates);
+void readInSteady(int argc, char *argv[], steadySettings & settings);
+void batch(const string & pattern, const vector<option> & opts, int loaders, int simulators);
+void batchLoader(batchRun & run);
+void batchSimulator(batchRun & run, const vector<option> & opts);
+void printBatchReport(const batchRun & run, const vector<option> & opts);
+void serve(string socketPath, int workers);
+void serveWorker(simServer & server);
+void serveConnection(shared_ptr<simServer> server, shared_ptr<serverConnection> conn);
+void handleRequest(simServer & server, shared_ptr<serverConnection> conn, const string & line);
+void sendLine(serverConnection & conn, const string & line);
+bool parseJson(const string & text, int & pos, jsonValue & v);
+string jsonString(const string & text);
 void printReport(const vector<option> & opts, const vector< vector<processStats> > & pStats, const vector<int> & totalTimes, const vector<int> & idleTimes);
-void readInProcesses(string filename, vector<process> & ps);
+phaseProfile beginPhase(const string & name);
+void endPhase(phaseProfile & phase, vector<phaseProfile> & profile);
+long processPeakMemory();
+long residentHighWater();
+double cpuSeconds();
+void printProfile(const vector<phaseProfile> & profile, bool json);
+void readInProcesses(string filename, vector<process> & ps, vector<int> & ioTable);
+bool parseProcess(const string & line, process & pr, vector<int> & ioTable, string & error);
+bool loadProcesses(string filename, vector<process> & ps, vector<int> & ioTable, string & error);
 void readInOptions(string filename, vector<option> & opts);
+bool parseOption(const string & line, option & opt, string & error);
+bool readInModifiers(const string & line, int end, vector<int> & values);
+bool parseInt(const string & text, int & value, string & error);
 
 int main(int argc, char *argv[]) 
 {
 	vector<process> processes;
+	vector<int> ioTable; //the processes' i/o bursts (see workload)
 	vector<option> options;
-	readInProcesses("P.dat", processes);
+	/* keep workloads in memory and answer simulation requests over a unix socket */
+	if(argc>1 && string(argv[1])=="--serve")
+	{
+		if(argc<3)
+		{
+			cerr << "ERROR-- main: usage: " << argv[0] << " --serve SocketPath [Workers]" << endl;
+			exit(EXIT_FAILURE);
+		}
+		int workers = (argc>3) ? atoi(argv[3]) : (int)thread::hardware_concurrency();
+		serve(argv[2], max(1, workers));
+		return 0;
+	}
+	/**/
+	/* estimate the steady state of each option in S.dat under a synthetic open workload */
+	if(argc>1 && string(argv[1])=="--steady")
+	{
+		steadySettings settings;
+		readInSteady(argc, argv, settings);
+		readInOptions("S.dat", options);
+		vector<steadyEstimate> estimates;
+		for(int i=0; i<options.size(); i++) estimates.push_back(steadyState(options[i], settings));
+		printSteadyReport(options, estimates);
+		return 0;
+	}
+	/**/
+	/* simulate every trace matching a directory or glob under each option in S.dat */
+	if(argc>1 && string(argv[1])=="--batch")
+	{
+		if(argc<3)
+		{
+			cerr << "ERROR-- main: usage: " << argv[0] << " --batch DirectoryOrGlob [Loaders [Simulators]]" << endl;
+			exit(EXIT_FAILURE);
+		}
+		int loaders = (argc>3) ? atoi(argv[3]) : 2;
+		int simulators = (argc>4) ? atoi(argv[4]) : (int)thread::hardware_concurrency();
+		readInOptions("S.dat", options);
+		batch(argv[2], options, max(1, loaders), max(1, simulators));
+		return 0;
+	}
+	/**/
+	vector<phaseProfile> profile;
+	phaseProfile phase = beginPhase("readInProcesses");
+	readInProcesses("P.dat", processes, ioTable);
+	endPhase(phase, profile);
+	/* search for the best slice parameters instead of running the options in S.dat */
+	if(argc>1 && string(argv[1])=="--optimize")
+	{
+		optimizer o;
+		readInOptimizer(argc, argv, processes, ioTable, o);
+		optimize(processes, ioTable, o);
+		return 0;
+	}
+	/**/
+	phase = beginPhase("readInOptions");
 	readInOptions("S.dat", options);
+	endPhase(phase, profile);
 	vector< vector<processStats> > pStats(options.size(), vector<processStats>());
 	vector<int> totalTimes(options.size(), 0);
 	vector<int> idleTimes(options.size(), 0);
-	for(int i=0; i<options.size(); i++)
+	/* read the simulation flags */
+	bool lockstep = false;
+	int splitThreads = 0; //0 simulates each option in one piece
+	bool profiling = false;
+	bool profileJson = false;
+	windowRecorder * windows = NULL; //records windowed metrics if --windows is given
+	for(int a=1; a<argc; a++)
 	{
-		switch (options[i].alg) 
+		string arg = argv[a];
+		if(arg=="--lockstep") lockstep = true;
+		else if(arg=="--split")
 		{
-			case FCFS:
-				fcfs(processes, totalTimes[i], idleTimes[i], pStats[i]);
-				break;
-			case NPSJF:
-				npsjf(processes, totalTimes[i], idleTimes[i], pStats[i]);
-				break;
-			case PSJF:
-				psjf(processes, totalTimes[i], idleTimes[i], pStats[i]);
-				break;
-			case RR:
-				rr(processes, options[i].slice, options[i].switchTime, totalTimes[i], idleTimes[i], pStats[i]);
-				break;
-			case RRP:
-				rrp(processes, options[i].slice, options[i].prioritySlice, options[i].switchTime, totalTimes[i], idleTimes[i], pStats[i]);
-				break;
-			default: 
-				break;
+			if(a+1<argc && isdigit(argv[a+1][0])) splitThreads = atoi(argv[++a]);
+			else splitThreads = (int)thread::hardware_concurrency();
+			splitThreads = max(1, splitThreads);
 		}
-		
+		else if(arg=="--windows")
+		{
+			if(a+1>=argc || atoi(argv[a+1])<=0)
+			{
+				cerr << "ERROR-- main: --windows MUST be followed by a window length > 0." << endl;
+				exit(EXIT_FAILURE);
+			}
+			windows = new windowRecorder();
+			windows->length = atoi(argv[++a]);
+			windows->out = &cout;
+		}
+		else if(arg=="--profile")
+		{
+			profiling = true;
+			if(a+1<argc && (string(argv[a+1])=="json" || string(argv[a+1])=="table")) profileJson = (string(argv[++a])=="json");
+		}
+		else
+		{
+			cerr << "ERROR-- main: '" << arg << "' is not supported." << endl;
+			exit(EXIT_FAILURE);
+		}
+	}
+	if(windows && (lockstep || splitThreads>0))
+	{
+		cerr << "ERROR-- main: --windows can not be combined with --lockstep or --split." << endl;
+		exit(EXIT_FAILURE);
+	}
+	if((lockstep || splitThreads>0) && hasIo(processes)) //the lanes and busy period threads only model a single cpu burst per process
+	{
+		cerr << "NOTE-- main: --lockstep and --split are ignored for processes with i/o bursts, each option is simulated on its own." << endl;
+		lockstep = false;
+		splitThreads = 0;
+	}
+	/**/
+	/* simulate every RR and RRP option side by side in one pass over the processes */
+	vector<option> lanes;
+	vector<int> laneOptions;
+	for(int i=0; lockstep && i<options.size(); i++)
+	{
+		if(options[i].alg==RR || options[i].alg==RRP)
+		{
+			lanes.push_back(options[i]);
+			laneOptions.push_back(i);
+		}
+	}
+	if(lanes.size()>0)
+	{
+		vector< vector<processStats> > laneStats;
+		vector<int> laneTotals;
+		vector<int> laneIdles;
+		phase = beginPhase("lockstep (" + to_string(lanes.size()) + " options)");
+		rrLockstep(processes, lanes, laneTotals, laneIdles, laneStats);
+		for(int l=0; l<lanes.size(); l++)
+		{
+			pStats[laneOptions[l]].swap(laneStats[l]);
+			totalTimes[laneOptions[l]] = laneTotals[l];
+			idleTimes[laneOptions[l]] = laneIdles[l];
+			phase.simulatedTime += laneTotals[l];
+			phase.jobs += processes.size();
+		}
+		endPhase(phase, profile);
+	}
+	/**/
+	for(int i=0; i<options.size(); i++)
+	{
+		if(lockstep && (options[i].alg==RR || options[i].alg==RRP)) continue;
+		phase = beginPhase(optionName(options[i]));
+		if(windows) startWindows(windows, optionName(options[i]));
+		if(splitThreads>0) simulateSplit(processes, ioTable, options[i], splitThreads, totalTimes[i], idleTimes[i], pStats[i]);
+		else simulate(processes, ioTable, options[i], totalTimes[i], idleTimes[i], pStats[i], windows);
+		if(windows) flushWindows(windows);
+		phase.simulatedTime = totalTimes[i];
+		phase.jobs = processes.size();
+		endPhase(phase, profile);
 	}
+	phase = beginPhase("printReport");
 	printReport(options, pStats, totalTimes, idleTimes);
+	endPhase(phase, profile);
+	if(profiling) printProfile(profile, profileJson);
+	delete windows;
+}
+
+/* Function:	simulate
+ *    Usage:	int totalTime;
+ *				int idleTime;
+ *				vector<processStats> pStats;
+ *    			simulate(ps, ioTable, opt, totalTime, idleTime, pStats);
+ *  -------------------------------------------
+ *  Runs the simulation of the scheduling algorithm selected by 'opt'.
+ *  - ps: contains the processes to schedule and execute
+ *  - ioTable: the i/o table of the processes (see workload)
+ *  - opt: the cpu scheduling option to simulate
+ *  - totalTime: set to equal the total time of execution
+ *  - idleTime: set to equal the total time the cpu is idle
+ *  - pStats: set to contain the timing statistics for each process
+ *  - windows: if not NULL, records the metrics of each window of simulated time
+ */
+void simulate(const vector<process> & ps, const vector<int> & ioTable, const option & opt, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows)
+{
+	switch (opt.alg) 
+	{
+		case FCFS:
+			fcfs(ps, ioTable, totalTime, idleTime, pStats, windows);
+			break;
+		case NPSJF:
+			npsjf(ps, ioTable, totalTime, idleTime, pStats, windows);
+			break;
+		case PSJF:
+			psjf(ps, ioTable, totalTime, idleTime, pStats, windows);
+			break;
+		case RR:
+			rr(ps, ioTable, opt.slice, opt.switchTime, totalTime, idleTime, pStats, windows);
+			break;
+		case RRP:
+			rrp(ps, ioTable, opt.slice, opt.prioritySlice, opt.switchTime, totalTime, idleTime, pStats, windows);
+			break;
+		case CFS:
+			cfs(ps, ioTable, opt.latency, opt.granularity, opt.switchTime, totalTime, idleTime, pStats, windows);
+			break;
+		case MLFQ:
+			mlfq(ps, ioTable, opt.levels, opt.slice, opt.boostPeriod, opt.switchTime, totalTime, idleTime, pStats, windows);
+			break;
+		case EDF:
+			edf(ps, ioTable, totalTime, idleTime, pStats, windows);
+			break;
+		default: 
+			break;
+	}
 }
 
 /* Function:	fcfs
  *    Usage:	int totalTime;
  *				int idleTime
  *				vector<processStats> pStats;
- *    			fcfs(ps, totalTime, idleTime, pStats);
+ *    			fcfs(ps, ioTable, totalTime, idleTime, pStats);
  *  -------------------------------------------
  *  Runs a simulation of the FCFS scheduling algorithm. 
  *  - ps: contains the processes to schedule and execute
+ *  - ioTable: the i/o table of the processes (see workload)
  *  - totalTime: set to equal the total time of execution
  *  - idleTime: set to equal the total time the cpu is idle
  *  - pStats: set to contain the timing statistics for each process
+ *  - windows: if not NULL, records the metrics of each window of simulated time
  */
-void fcfs(vector<process> ps, int & totalTime, int & idleTime, vector<processStats> & pStats)
+void fcfs(vector<process> ps, const vector<int> & ioTable, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows)
 {
 	pStats.clear();
 	totalTime = 0;
 	idleTime = 0;
 	deque<processBlock> ready;
+	timerHeap<processBlock> blocked; //processes waiting for i/o
+	bool io = hasIo(ps); //without i/o bursts nothing ever blocks, so the blocked heap is left alone
 	processBlock cpu;
 	bool running = false;
-	while(running || ps.size()+ready.size()>0)
+	while(running || ps.size()+ready.size()+blocked.size()>0)
 	{
-		/* there are no processes currently in the system */
-		if(!running && ready.size()==0 && totalTime<ps[0].arrival)
+		/* there are no processes ready to run until the next arrival or i/o completion */
+		if(!running && ready.size()==0 && totalTime<(io ? nextEvent(ps, blocked) : ps[0].arrival))
 		{
+			if(windows) recordSpan(windows, totalTime, 1, false, 0);
 			idleTime++;
 			totalTime++;
 		}
 		/**/
 		else
 		{
-			/* add any arriving processes to the end of the ready queue */
+			/* add any arriving processes, then any processes finishing i/o, to the end of the ready queue */
 			if(ps.size()>0 && totalTime==ps[0].arrival)
 			{
 				addNewArrivals(ps, ready);
 			}
+			if(io) addWakeUps(blocked, totalTime, ready);
 			/**/
 			/* if the cpu is idle, move the next process in the ready queue onto the cpu for running */
 			if(!running)
@@ -142,12 +618,18 @@ void fcfs(vector<process> ps, int & totalTime, int & idleTime, vector<processSta
 			}
 			/**/
 			/* run the current process 1 time unit */
+			if(windows) recordSpan(windows, totalTime, 1, true, ready.size());
 			cpu.p.burst--;
 			cpu.s.turnAround++;
 			totalTime++;
-			if(cpu.p.burst == 0) //if the process is finished, save its timing stats
+			if(io && cpu.p.burst==0 && blockOnIo(cpu, ioTable, totalTime, blocked)) //if an i/o burst follows the cpu burst, block the process until it completes
+			{
+				running = false;
+			}
+			else if(cpu.p.burst == 0) //if the process is finished, save its timing stats
 			{
 				pStats.push_back(cpu.s);
+				if(windows) recordCompletion(windows, totalTime, cpu.s.waiting);
 				running = false;
 			}
 			/**/
@@ -159,38 +641,44 @@ void fcfs(vector<process> ps, int & totalTime, int & idleTime, vector<processSta
  *    Usage:	int totalTime;
  *				int idleTime;
  *				vector<processStats> pStats;
- *   			npsjf(ps, totalTime, idleTime, pStats);
+ *   			npsjf(ps, ioTable, totalTime, idleTime, pStats);
  *  -------------------------------------------
  *  Runs a simulation of the NPSJF scheduling algorithm. 
  *  - ps: contains the processes to schedule and execute
+ *  - ioTable: the i/o table of the processes (see workload)
  *  - totalTime: set to equal the total time of execution
  *  - idleTime: set to equal the total time the cpu is idle
  *  - pStats: set to contain the timing statistics for each process
+ *  - windows: if not NULL, records the metrics of each window of simulated time
  */
-void npsjf(vector<process> ps, int & totalTime, int & idleTime, vector<processStats> & pStats)
+void npsjf(vector<process> ps, const vector<int> & ioTable, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows)
 {
 	pStats.clear();
 	totalTime = 0;
 	idleTime = 0;
 	deque<processBlock> ready;
+	timerHeap<processBlock> blocked; //processes waiting for i/o
+	bool io = hasIo(ps); //without i/o bursts nothing ever blocks, so the blocked heap is left alone
 	processBlock cpu;
 	bool running = false;
-	while(running || ps.size()+ready.size()>0)
+	while(running || ps.size()+ready.size()+blocked.size()>0)
 	{
-		/* there are no processes currently in the system */
-		if(!running && ready.size()==0 && totalTime<ps[0].arrival)
+		/* there are no processes ready to run until the next arrival or i/o completion */
+		if(!running && ready.size()==0 && totalTime<(io ? nextEvent(ps, blocked) : ps[0].arrival))
 		{
+			if(windows) recordSpan(windows, totalTime, 1, false, 0);
 			idleTime++;
 			totalTime++;
 		}
 		/**/
 		else
 		{
-			/* add any arriving processes to the appropriate position in the ready queue*/
+			/* add any arriving or waking processes to the appropriate position in the ready queue*/
 			if(ps.size()>0 && totalTime==ps[0].arrival)
 			{
 				addNewArrivalsInOrder(ps, ready);
 			}
+			if(io) addWakeUpsInOrder(blocked, totalTime, ready);
 			/**/
 			/* if the cpu is idle, move the next process in the ready queue onto the cpu for running */
 			if(!running)
@@ -208,12 +696,18 @@ void npsjf(vector<process> ps, int & totalTime, int & idleTime, vector<processSt
 			}
 			/**/
 			/* run the current process for 1 time unit */
+			if(windows) recordSpan(windows, totalTime, 1, true, ready.size());
 			cpu.p.burst--;
 			cpu.s.turnAround++;
 			totalTime++;
-			if(cpu.p.burst==0) //if the process is finished, save its timing stats
+			if(io && cpu.p.burst==0 && blockOnIo(cpu, ioTable, totalTime, blocked)) //if an i/o burst follows the cpu burst, block the process until it completes
+			{
+				running = false;
+			}
+			else if(cpu.p.burst==0) //if the process is finished, save its timing stats
 			{
 				pStats.push_back(cpu.s);
+				if(windows) recordCompletion(windows, totalTime, cpu.s.waiting);
 				running = false;
 			}
 			/**/
@@ -225,45 +719,52 @@ void npsjf(vector<process> ps, int & totalTime, int & idleTime, vector<processSt
  *    Usage:	int totalTime;
  *				int idleTime;
  *				vector<processStats> pStats;
- *    			psjf(ps, totalTime, idleTime, pStats);
+ *    			psjf(ps, ioTable, totalTime, idleTime, pStats);
  *  -------------------------------------------
  *  Runs a simulation of the PSJF scheduling algorithm. 
  *  - ps: contains the processes to schedule and execute
+ *  - ioTable: the i/o table of the processes (see workload)
  *  - totalTime: set to equal the total time of execution
  *  - idleTime: set to equal the total time the cpu is idle
  *  - pStats: set to contain the timing statistics for each process
+ *  - windows: if not NULL, records the metrics of each window of simulated time
  */
-void psjf(vector<process> ps, int & totalTime, int & idleTime, vector<processStats> & pStats)
+void psjf(vector<process> ps, const vector<int> & ioTable, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows)
 {
 	pStats.clear();
 	totalTime = 0;
 	idleTime = 0;
 	deque<processBlock> ready;
+	timerHeap<processBlock> blocked; //processes waiting for i/o
+	bool io = hasIo(ps); //without i/o bursts nothing ever blocks, so the blocked heap is left alone
 	processBlock cpu;
 	bool running = false;
-	while(running || ps.size()+ready.size()>0)
+	while(running || ps.size()+ready.size()+blocked.size()>0)
 	{
-		/* there are no processes currently in the system */
-		if(!running && ready.size()==0 && totalTime<ps[0].arrival)
+		/* there are no processes ready to run until the next arrival or i/o completion */
+		if(!running && ready.size()==0 && totalTime<(io ? nextEvent(ps, blocked) : ps[0].arrival))
 		{
+			if(windows) recordSpan(windows, totalTime, 1, false, 0);
 			idleTime++;
 			totalTime++;
 		}
 		/**/
 		else
 		{
-			/* add any arriving processes to the appropriate position in the ready queue*/
+			/* add any arriving or waking processes to the appropriate position in the ready queue*/
 			if(ps.size()>0 && totalTime==ps[0].arrival)
 			{
 				addNewArrivalsInOrder(ps, ready);
-				/* preempt the current process if a new arrival has a shorter burst */
-				if(running && cpu.p.burst>ready[0].p.burst)
-				{
-					addProcessBlockByBurst(cpu, ready);
-					cpu = ready.front();
-					ready.pop_front();
-				}
-				/**/
+			}
+			if(io) addWakeUpsInOrder(blocked, totalTime, ready);
+			/**/
+			/* preempt the current process if a new arrival or waking process has a shorter burst
+			 * (nothing else in the ready queue can be shorter than the current process) */
+			if(running && ready.size()>0 && cpu.p.burst>ready[0].p.burst)
+			{
+				addProcessBlockByBurst(cpu, ready);
+				cpu = ready.front();
+				ready.pop_front();
 			}
 			/**/
 			/* if the cpu is idle, move the next process in the ready queue onto the cpu for running */
@@ -282,12 +783,18 @@ void psjf(vector<process> ps, int & totalTime, int & idleTime, vector<processSta
 			}
 			/**/
 			/* run the current process for 1 time unit */
+			if(windows) recordSpan(windows, totalTime, 1, true, ready.size());
 			cpu.p.burst--;
 			cpu.s.turnAround++;
 			totalTime++;
-			if(cpu.p.burst == 0) //if the process is finished, save its timing stats
+			if(io && cpu.p.burst==0 && blockOnIo(cpu, ioTable, totalTime, blocked)) //if an i/o burst follows the cpu burst, block the process until it completes
+			{
+				running = false;
+			}
+			else if(cpu.p.burst == 0) //if the process is finished, save its timing stats
 			{
 				pStats.push_back(cpu.s);
+				if(windows) recordCompletion(windows, totalTime, cpu.s.waiting);
 				running = false;
 			}
 			/**/
@@ -300,41 +807,47 @@ void psjf(vector<process> ps, int & totalTime, int & idleTime, vector<processSta
  *				int totalTime;
  *				int idleTime;
  *				vector<processStats> pStats;
- *    			rr(ps, slice, switchTime, totalTime, idleTime, pStats);
+ *    			rr(ps, ioTable, slice, switchTime, totalTime, idleTime, pStats);
  *  -------------------------------------------
  *  Runs a simulation of the RR scheduling algorithm. 
  *  - ps: contains the processes to schedule and execute
+ *  - ioTable: the i/o table of the processes (see workload)
  *  - slice: the time quantum each process receives
  *  - switchTime: the time it takes to switch processes
  *  - totalTime: set to equal the total time of execution
  *  - idleTime: set to equal the total time the cpu is idle
  *  - pStats: set to contain the timing statistics for each process
+ *  - windows: if not NULL, records the metrics of each window of simulated time
  */
-void rr(vector<process> ps, int slice, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats)
+void rr(vector<process> ps, const vector<int> & ioTable, int slice, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows)
 {
 	pStats.clear();
 	totalTime = 0;
 	idleTime = 0;
 	deque<processBlock> ready;
+	timerHeap<processBlock> blocked; //processes waiting for i/o
+	bool io = hasIo(ps); //without i/o bursts nothing ever blocks, so the blocked heap is left alone
 	int timeRunning = 0;
 	processBlock cpu;
 	bool running = false;
-	while(running || ps.size()+ready.size()>0)
+	while(running || ps.size()+ready.size()+blocked.size()>0)
 	{
-		/* there are no processes currently in the system */
-		if(!running && ready.size()==0 && totalTime<ps[0].arrival)
+		/* there are no processes ready to run until the next arrival or i/o completion */
+		if(!running && ready.size()==0 && totalTime<(io ? nextEvent(ps, blocked) : ps[0].arrival))
 		{
+			if(windows) recordSpan(windows, totalTime, 1, false, 0);
 			idleTime++;
 			totalTime++;
 		}
 		/**/
 		else
 		{
-			/* add any arriving processes to the end of the ready queue */
+			/* add any arriving processes, then any processes finishing i/o, to the end of the ready queue */
 			if(ps.size()>0 && totalTime==ps[0].arrival)
 			{
 				addNewArrivals(ps, ready);
 			}
+			if(io) addWakeUps(blocked, totalTime, ready);
 			/**/
 			/* if the cpu is idle, move the next process in the ready queue onto the cpu for running */
 			if(!running)
@@ -348,13 +861,15 @@ void rr(vector<process> ps, int slice, int switchTime, int & totalTime, int & id
 						ready[i].s.waiting++;
 						ready[i].s.turnAround++;
 					}
+					if(windows) recordSpan(windows, totalTime, 1, false, ready.size());
 					idleTime++;
 					totalTime++;
-					/* add any arriving processes to the end of the ready queue */
+					/* add any arriving processes, then any processes finishing i/o, to the end of the ready queue */
 					if(ps.size()>0 && totalTime==ps[0].arrival)
 					{
 						addNewArrivals(ps, ready);
 					}
+					if(io) addWakeUps(blocked, totalTime, ready);
 					/**/
 				}
 				/**/
@@ -372,22 +887,29 @@ void rr(vector<process> ps, int slice, int switchTime, int & totalTime, int & id
 			}
 			/**/
 			/* run the current process for 1 time unit */
+			if(windows) recordSpan(windows, totalTime, 1, true, ready.size());
 			cpu.p.burst--;
 			cpu.s.turnAround++;
 			timeRunning++;
 			totalTime++;
-			if(cpu.p.burst==0) //if the process is finished, save its timing stats
+			if(io && cpu.p.burst==0 && blockOnIo(cpu, ioTable, totalTime, blocked)) //if an i/o burst follows the cpu burst, block the process until it completes
+			{
+				running = false;
+			}
+			else if(cpu.p.burst==0) //if the process is finished, save its timing stats
 			{	
 				pStats.push_back(cpu.s);
+				if(windows) recordCompletion(windows, totalTime, cpu.s.waiting);
 				running=false;
 			}
 			else if(timeRunning==slice) //if the process has used up its time slice, preempt it
 			{
-				//add any arriving processes to the end of the ready queue ahead of the preempted process
+				//add any arriving or waking processes to the end of the ready queue ahead of the preempted process
 				if(ps.size()>0 && totalTime==ps[0].arrival)
 				{
 					addNewArrivals(ps, ready);
 				}
+				if(io) addWakeUps(blocked, totalTime, ready);
 				ready.push_back(cpu);
 				running = false;
 			}
@@ -401,43 +923,49 @@ void rr(vector<process> ps, int slice, int switchTime, int & totalTime, int & id
  *				int totalTime;
  *				int idleTime;
  *				vector<processStats> pStats;
- *    			rrp(ps, slice, int prioritySlice, switchTime, totalTime, idleTime, pStats);
+ *    			rrp(ps, ioTable, slice, int prioritySlice, switchTime, totalTime, idleTime, pStats);
  * -------------------------------------------
  *  Runs a simulation of the RRP (round robin priority) scheduling algorithm. 
  *  - ps: contains the processes to schedule and execute
+ *  - ioTable: the i/o table of the processes (see workload)
  *  - slice: the time quantum each process receives
  *  - prioritySlice: if a process has burst<prioritySlice, it runs to completion
  *  - switchTime: the time it takes to switch processes
  *  - totalTime: set to equal the total time of execution
  *  - idleTime: set to equal the total time the cpu is idle
  *  - pStats: set to contain the timing statistics for each process
+ *  - windows: if not NULL, records the metrics of each window of simulated time
  */
-void rrp(vector<process> ps, int slice, int prioritySlice, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats)
+void rrp(vector<process> ps, const vector<int> & ioTable, int slice, int prioritySlice, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows)
 {
 	pStats.clear();
 	totalTime = 0;
 	idleTime = 0;
 	deque<processBlock> ready;
+	timerHeap<processBlock> blocked; //processes waiting for i/o
+	bool io = hasIo(ps); //without i/o bursts nothing ever blocks, so the blocked heap is left alone
 	int timeRunning = 0;
 	processBlock cpu;
 	bool running = false;
 	int currentSlice = slice;
-	while(running || ps.size()+ready.size()>0)
+	while(running || ps.size()+ready.size()+blocked.size()>0)
 	{
-		/* there are no processes currently in the system */
-		if(!running && ready.size()==0 && totalTime<ps[0].arrival)
+		/* there are no processes ready to run until the next arrival or i/o completion */
+		if(!running && ready.size()==0 && totalTime<(io ? nextEvent(ps, blocked) : ps[0].arrival))
 		{
+			if(windows) recordSpan(windows, totalTime, 1, false, 0);
 			idleTime++;
 			totalTime++;
 		}
 		/**/
 		else
 		{
-			/* add any arriving processes to the end of the ready queue */
+			/* add any arriving processes, then any processes finishing i/o, to the end of the ready queue */
 			if(ps.size()>0 && totalTime==ps[0].arrival)
 			{
 				addNewArrivals(ps, ready);
 			}
+			if(io) addWakeUps(blocked, totalTime, ready);
 			/**/
 			/* if the cpu is idle, move the next process in the ready queue onto the cpu for running */
 			if(!running)
@@ -451,13 +979,15 @@ void rrp(vector<process> ps, int slice, int prioritySlice, int switchTime, int &
 						ready[i].s.waiting++;
 						ready[i].s.turnAround++;
 					}
+					if(windows) recordSpan(windows, totalTime, 1, false, ready.size());
 					idleTime++;
 					totalTime++;
-					/* add any arriving processes to the end of the ready queue */
+					/* add any arriving processes, then any processes finishing i/o, to the end of the ready queue */
 					if(ps.size()>0 && totalTime==ps[0].arrival)
 					{
 						addNewArrivals(ps, ready);
 					}
+					if(io) addWakeUps(blocked, totalTime, ready);
 					/**/
 				}
 				/**/
@@ -479,22 +1009,29 @@ void rrp(vector<process> ps, int slice, int prioritySlice, int switchTime, int &
 			}
 			/**/
 			/* run the current process for 1 time unit */
+			if(windows) recordSpan(windows, totalTime, 1, true, ready.size());
 			cpu.p.burst--;
 			cpu.s.turnAround++;
 			timeRunning++;
 			totalTime++;
-			if(cpu.p.burst==0) //if the process is finished, save its timing stats
+			if(io && cpu.p.burst==0 && blockOnIo(cpu, ioTable, totalTime, blocked)) //if an i/o burst follows the cpu burst, block the process until it completes
+			{
+				running = false;
+			}
+			else if(cpu.p.burst==0) //if the process is finished, save its timing stats
 			{	
 				pStats.push_back(cpu.s);
+				if(windows) recordCompletion(windows, totalTime, cpu.s.waiting);
 				running=false;
 			}
 			else if(timeRunning==currentSlice) //if the process has used up its time slice, preempt it
 			{
-				//add any arriving processes to the end of the ready queue ahead of the preempted process
+				//add any arriving or waking processes to the end of the ready queue ahead of the preempted process
 				if(ps.size()>0 && totalTime==ps[0].arrival)
 				{
 					addNewArrivals(ps, ready);
 				}
+				if(io) addWakeUps(blocked, totalTime, ready);
 				ready.push_back(cpu);
 				running = false;
 			}
@@ -503,98 +1040,2058 @@ void rrp(vector<process> ps, int slice, int prioritySlice, int switchTime, int &
 	}
 }
 
-/* Function:	addProcessByArrival
- *    Usage:	vector<process> ps 
- *				addProcessByArrival(p, ps);
- * -------------------------------------------
- * Adds the process in the apporpriate position in the vector, 
- * keeps it sorted by arrival time from least to greatest.
- */
-void addProcessByArrival(process & p,  vector<process> & ps)
-{
-	if(ps.size()==0 || p.arrival >= ps.back().arrival )
-		ps.push_back(p);
-	else 
-	{
-		int i = (int)ps.size()-1;
-		ps.resize(ps.size()+1);
-		do
-		{
-			ps[i+1] = ps[i];
-			i--;
-		} while(i>=0 && p.arrival<ps[i].arrival);
-		ps[i+1] = p;
-	}
-}
-
-/* Function:	addProcessBlockByBurst
- *    Usage:	deque<processBlock> p 
- *				addProcessBlockByBurst(b, bs);
+/* Function:	cfs
+ *    Usage:	int totalTime;
+ *				int idleTime;
+ *				vector<processStats> pStats;
+ *    			cfs(ps, ioTable, latency, granularity, switchTime, totalTime, idleTime, pStats);
  *  -------------------------------------------
- *  Adds the processBlock in the apporpriate position in the vector, 
- *  keeps it sorted by the processescpu burst time from least to greatest.
+ *  Runs a simulation of the CFS (completely fair scheduler) scheduling algorithm, modeled on Linux.
+ *  Runnable processes are kept in a red-black tree (std::map) ordered by virtual runtime, the cpu time a process
+ *  has received scaled by its nice weight; the process with the smallest virtual runtime runs next.
+ *  A process runs for its weighted share of the scheduling period, then goes back in the tree behind any process with
+ *  the same virtual runtime, and the leftmost process runs next (as in Linux), so processes that tie take turns.
+ *  Arriving processes start at the smallest virtual runtime in the system and preempt the running
+ *  process if it is ahead of them by more than 'granularity'. A process that blocks on i/o leaves the tree until
+ *  the i/o completes, then keeps its virtual runtime but is placed no more than half a latency behind the smallest
+ *  (so a long sleeper can not monopolize the cpu), and preempts like an arrival.
+ *  Time advances from event to event (arrival, i/o completion, slice end, completion), so each event costs O(log n).
+ *  - ps: contains the processes to schedule and execute
+ *  - ioTable: the i/o table of the processes (see workload)
+ *  - latency: the targeted period in which every runnable process runs once
+ *  - granularity: the minimum time slice; the period grows when more than latency/granularity processes are runnable
+ *  - switchTime: the time it takes to switch processes
+ *  - totalTime: set to equal the total time of execution
+ *  - idleTime: set to equal the total time the cpu is idle
+ *  - pStats: set to contain the timing statistics for each process
+ *  - windows: if not NULL, records the metrics of each window of simulated time
  */
-void addProcessBlockByBurst(processBlock & b, deque<processBlock> & bs)
+void cfs(vector<process> ps, const vector<int> & ioTable, int latency, int granularity, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows)
 {
-	if(bs.size()==0 || b.p.burst >= bs.back().p.burst )
-		bs.push_back(b);
-	else 
+	pStats.clear();
+	totalTime = 0;
+	idleTime = 0;
+	vector<cfsEntity> entities(ps.size());
+	map< pair<long long,long long>, int > tree; //runnable processes (not on the cpu) by virtual runtime, then insertion order
+	long long inserted = 0; //insertions so far, so that a process goes behind the processes with the same virtual runtime
+	timerHeap<int> blocked; //processes waiting for i/o
+	long long minVruntime = 0;
+	long long totalWeight = 0;
+	int next = 0;		//the next process to arrive
+	int cpu = -1;		//the entity on the cpu, -1 if none
+	long long sliceLength = 0;
+	long long timeRunning = 0;
+	long long startVruntime = 0; //virtual runtime of the process on the cpu when it was swapped in
+	while(cpu>=0 || tree.size()>0 || next<ps.size() || blocked.size()>0)
 	{
-		int i = (int)bs.size()-1;
-		bs.resize(bs.size()+1);
-		do
+		/* there are no processes ready to run until the next arrival or i/o completion */
+		long long event = LLONG_MAX;
+		if(next<ps.size()) event = ps[next].arrival;
+		if(blocked.size()>0) event = min(event, blocked.top().first.first);
+		if(cpu<0 && tree.size()==0 && totalTime<event)
 		{
-			bs[i+1] = bs[i];
-			i--;
-		} while(i>=0 && b.p.burst<bs[i].p.burst);
-		bs[i+1] = b;
+			if(windows) recordSpan(windows, totalTime, event-totalTime, false, 0);
+			idleTime += event - totalTime;
+			totalTime = event;
+		}
+		/**/
+		/* add any arriving processes to the tree, preempting the current process if it is too far ahead of them */
+		bool preempt = false;
+		for(; next<ps.size() && ps[next].arrival<=totalTime; next++)
+		{
+			cfsEntity & e = entities[next];
+			e.b = newProcessBlock(ps[next]);
+			e.burst = serviceTime(ps[next], ioTable);
+			e.weight = NICE_WEIGHT[ps[next].nice+20];
+			e.vruntime = minVruntime;
+			tree.insert(make_pair(make_pair(e.vruntime, inserted++), next));
+			totalWeight += e.weight;
+			if(cpu>=0 && entities[cpu].vruntime - e.vruntime > ((long long)granularity<<16)) preempt = true;
+		}
+		/* processes finishing i/o keep their virtual runtime, but no more than half a latency behind the smallest */
+		for(; blocked.size()>0 && blocked.top().first.first<=totalTime; blocked.pop())
+		{
+			cfsEntity & e = entities[blocked.top().second];
+			e.vruntime = max(e.vruntime, minVruntime - ((long long)latency<<15));
+			tree.insert(make_pair(make_pair(e.vruntime, inserted++), blocked.top().second));
+			totalWeight += e.weight;
+			if(cpu>=0 && entities[cpu].vruntime - e.vruntime > ((long long)granularity<<16)) preempt = true;
+		}
+		/**/
+		if(preempt)
+		{
+			tree.insert(make_pair(make_pair(entities[cpu].vruntime, inserted++), cpu));
+			cpu = -1;
+		}
+		/**/
+		/* if the cpu is idle, move the process with the smallest virtual runtime onto the cpu for running */
+		if(cpu<0)
+		{
+			/* increment times by the context switch time, adding the processes that arrive or wake during it;
+			 * it is assumed that context switch time only applies when swapping in*/
+			if(switchTime>0)
+			{
+				if(windows) recordSpan(windows, totalTime, switchTime, false, tree.size());
+				idleTime += switchTime;
+				totalTime += switchTime;
+				for(; next<ps.size() && ps[next].arrival<=totalTime; next++)
+				{
+					cfsEntity & e = entities[next];
+					e.b = newProcessBlock(ps[next]);
+					e.burst = serviceTime(ps[next], ioTable);
+					e.weight = NICE_WEIGHT[ps[next].nice+20];
+					e.vruntime = minVruntime;
+					tree.insert(make_pair(make_pair(e.vruntime, inserted++), next));
+					totalWeight += e.weight;
+				}
+				for(; blocked.size()>0 && blocked.top().first.first<=totalTime; blocked.pop())
+				{
+					cfsEntity & e = entities[blocked.top().second];
+					e.vruntime = max(e.vruntime, minVruntime - ((long long)latency<<15));
+					tree.insert(make_pair(make_pair(e.vruntime, inserted++), blocked.top().second));
+					totalWeight += e.weight;
+				}
+			}
+			/**/
+			cpu = tree.begin()->second;
+			tree.erase(tree.begin());
+			timeRunning = 0;
+			startVruntime = entities[cpu].vruntime;
+			/* the slice is the process' weighted share of the period */
+			long long runnable = tree.size()+1;
+			long long period = latency;
+			if(runnable*granularity > period) period = runnable*granularity;
+			sliceLength = max(1LL, period*entities[cpu].weight/totalWeight);
+			/**/
+		}
+		/**/
+		/* run the current process until its cpu burst finishes, its slice ends or the next process arrives or wakes */
+		cfsEntity & c = entities[cpu];
+		long long run = min(sliceLength-timeRunning, (long long)c.b.p.burst);
+		if(next<ps.size()) run = min(run, (long long)ps[next].arrival-totalTime);
+		if(blocked.size()>0) run = min(run, blocked.top().first.first-totalTime);
+		if(windows) recordSpan(windows, totalTime, run, true, tree.size());
+		c.b.p.burst -= run;
+		timeRunning += run;
+		totalTime += run;
+		c.vruntime = startVruntime + (timeRunning*NICE_0_LOAD<<16)/c.weight;
+		long long smallest = c.vruntime;
+		if(tree.size()>0) smallest = min(smallest, tree.begin()->first.first);
+		minVruntime = max(minVruntime, smallest);
+		int ioBurst;
+		if(c.b.p.burst==0 && startIo(c.b.p, ioTable, ioBurst)) //if an i/o burst follows the cpu burst, block the process until it completes
+		{
+			blocked.push(make_pair(make_pair((long long)totalTime+ioBurst, (long long)totalTime), cpu));
+			totalWeight -= c.weight;
+			cpu = -1;
+		}
+		else if(c.b.p.burst==0) //if the process is finished, save its timing stats
+		{
+			c.b.s.turnAround = totalTime - c.b.p.arrival;
+			c.b.s.waiting = c.b.s.turnAround - c.burst;
+			pStats.push_back(c.b.s);
+			if(windows) recordCompletion(windows, totalTime, c.b.s.waiting);
+			totalWeight -= c.weight;
+			cpu = -1;
+		}
+		else if(timeRunning==sliceLength) //if the slice is used up, put the process back and run the leftmost process
+		{
+			tree.insert(make_pair(make_pair(c.vruntime, inserted++), cpu));
+			if(tree.begin()->second==cpu) //it has still run the least, so it runs on without a context switch
+			{
+				tree.erase(tree.begin());
+				timeRunning = 0;
+				startVruntime = c.vruntime;
+			}
+			else cpu = -1;
+		}
+		/**/
 	}
 }
 
-/* Function:	addNewArrivals
- *    Usage:	deque<processBlock> bs
- *				addNewArrivals(ps, ready);
- *  -------------------------------------------
- *  For all processes in 'ps' that have the same arrival time as 'ps[0]', 
- *  a new 'processBlock' is created, initialized, and inserted at the end of 'ready'.
- */
-void addNewArrivals(vector<process> & ps, deque<processBlock> & ready)
-{
-	int arrive = ps[0].arrival;
-	do
-	{
-		processBlock b;
-		b.p = ps[0];
-		b.s = processStats();
-		ready.push_back(b);
-		ps.erase(ps.begin());
-	} while(ps.size()>0 && ps[0].arrival==arrive);
-}
-
-/* Function:	addNewArrivalsInOrder
- *    Usage:	deque<processBlock> bs
- *				addNewArrivalsInOrder(ps, ready);
+/* Function:	mlfq
+ *    Usage:	int totalTime;
+ *				int idleTime;
+ *				vector<processStats> pStats;
+ *    			mlfq(ps, ioTable, levels, quantum, boostPeriod, switchTime, totalTime, idleTime, pStats);
  *  -------------------------------------------
- *  For all processes in 'ps' that have the same arrival time as 'ps[0]', 
- *  a new 'processBlock' is created, initialized, and inserted at the correct position in 'ready'.
+ *  Runs a simulation of the MLFQ (multi-level feedback queue) scheduling algorithm.
+ *  Processes arrive at the top level and move down a level each time they use up the quantum of their level;
+ *  the quantum doubles at each lower level and the bottom level is round robin. The first process of the highest
+ *  non-empty level runs, and an arrival preempts a process running below the top level.
+ *  Every 'boostPeriod' all processes are moved back to the top level.
+ *  A process that blocks on i/o keeps its level and the part of its quantum it has used, so giving up the cpu
+ *  just before the quantum ends does not keep it at a high level; when the i/o completes it goes to the back of its level.
+ *  Each level is a FIFO queue and a bitmap records the non-empty levels, so the next process is found in O(1).
+ *  Time advances from event to event (arrival, i/o completion, quantum end, boost, completion).
+ *  - ps: contains the processes to schedule and execute
+ *  - ioTable: the i/o table of the processes (see workload)
+ *  - levels: the number of priority levels (at most MAX_MLFQ_LEVELS)
+ *  - quantum: the time slice of the top level
+ *  - boostPeriod: the time between priority boosts, 0 for none
+ *  - switchTime: the time it takes to switch processes
+ *  - totalTime: set to equal the total time of execution
+ *  - idleTime: set to equal the total time the cpu is idle
+ *  - pStats: set to contain the timing statistics for each process
+ *  - windows: if not NULL, records the metrics of each window of simulated time
  */
-void addNewArrivalsInOrder(vector<process> & ps, deque<processBlock> & ready)
+void mlfq(vector<process> ps, const vector<int> & ioTable, int levels, int quantum, int boostPeriod, int switchTime, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows)
 {
-	int arrive = ps[0].arrival;
-	do
+	pStats.clear();
+	totalTime = 0;
+	idleTime = 0;
+	vector< deque<mlfqBlock> > ready(levels);
+	unsigned int nonEmpty = 0; //bit i is set if level i has processes waiting
+	long long nextBoost = (boostPeriod>0) ? boostPeriod : LLONG_MAX;
+	int next = 0; //the next process to arrive
+	mlfqBlock cpu;
+	bool running = false;
+	bool expired = false; //the process on the cpu used up its quantum and goes to the back of its new level
+	timerHeap<mlfqBlock> blocked; //processes waiting for i/o
+	while(running || expired || nonEmpty!=0 || next<ps.size() || blocked.size()>0)
 	{
-		processBlock b;
-		b.p = ps[0];
-		b.s = processStats();
-		addProcessBlockByBurst(b, ready);
-		ps.erase(ps.begin());
-	} while(ps.size()>0 && ps[0].arrival==arrive);
-}
-
-/* Function:	printReport
- *    Usage:	printReport(opts, pStats, totalTimes, idleTimes);
- *  -------------------------------------------
- *  Prints out the results of multiple cpu scheduling option simulations.
+		/* there are no processes ready to run until the next arrival or i/o completion */
+		long long event = LLONG_MAX;
+		if(next<ps.size()) event = ps[next].arrival;
+		if(blocked.size()>0) event = min(event, blocked.top().first.first);
+		if(!running && !expired && nonEmpty==0 && totalTime<event)
+		{
+			if(windows) recordSpan(windows, totalTime, event-totalTime, false, 0);
+			idleTime += event - totalTime;
+			totalTime = event;
+		}
+		/**/
+		bool swapIn = !running;
+		for(int pass=0; pass<2; pass++)
+		{
+			/* add any arriving processes to the end of the top level */
+			for(; next<ps.size() && ps[next].arrival<=totalTime; next++)
+			{
+				mlfqBlock b;
+				b.b = newProcessBlock(ps[next]);
+				b.burst = serviceTime(ps[next], ioTable);
+				b.level = 0;
+				b.used = 0;
+				ready[0].push_back(b);
+				nonEmpty |= 1u;
+			}
+			/**/
+			/* add any processes finishing i/o to the end of their level */
+			for(; blocked.size()>0 && blocked.top().first.first<=totalTime; blocked.pop())
+			{
+				const mlfqBlock & b = blocked.top().second;
+				ready[b.level].push_back(b);
+				nonEmpty |= 1u<<b.level;
+			}
+			/**/
+			/* the expired process goes behind the processes arriving at the same time */
+			if(expired)
+			{
+				ready[cpu.level].push_back(cpu);
+				nonEmpty |= 1u<<cpu.level;
+				expired = false;
+			}
+			/**/
+			/* move every process back to the top level, keeping their order */
+			if(totalTime>=nextBoost)
+			{
+				while(nextBoost<=totalTime) nextBoost += boostPeriod;
+				for(int l=1; l<levels; l++)
+				{
+					for(int i=0; i<ready[l].size(); i++)
+					{
+						ready[l][i].level = 0;
+						ready[l][i].used = 0;
+						ready[0].push_back(ready[l][i]);
+					}
+					ready[l].clear();
+				}
+				nonEmpty = (ready[0].size()>0) ? 1u : 0;
+				if(running)
+				{
+					cpu.level = 0;
+					cpu.used = 0;
+				}
+			}
+			/**/
+			/* preempt the current process if a higher level has processes waiting */
+			if(running && (nonEmpty & ((1u<<cpu.level)-1))!=0)
+			{
+				ready[cpu.level].push_back(cpu);
+				nonEmpty |= 1u<<cpu.level;
+				running = false;
+				swapIn = true;
+			}
+			/**/
+			/* increment times by the context switch time before swapping in;
+			 * processes arriving during it are added on the second pass */
+			if(pass==0 && swapIn && switchTime>0)
+			{
+				if(windows)
+				{
+					int queued = 0;
+					for(int l=0; l<levels; l++) queued += ready[l].size();
+					recordSpan(windows, totalTime, switchTime, false, queued);
+				}
+				idleTime += switchTime;
+				totalTime += switchTime;
+			}
+			else break;
+			/**/
+		}
+		/* if the cpu is idle, move the first process of the highest non-empty level onto the cpu for running */
+		if(!running)
+		{
+			int level = __builtin_ctz(nonEmpty);
+			cpu = ready[level].front();
+			ready[level].pop_front();
+			if(ready[level].size()==0) nonEmpty &= ~(1u<<level);
+			running = true;
+		}
+		/**/
+		/* run the current process until its cpu burst finishes, it uses up its quantum, or the next arrival, wake up or boost */
+		long long levelQuantum = (long long)quantum<<cpu.level;
+		long long run = min(levelQuantum-cpu.used, (long long)cpu.b.p.burst);
+		if(next<ps.size()) run = min(run, (long long)ps[next].arrival-totalTime);
+		if(blocked.size()>0) run = min(run, blocked.top().first.first-totalTime);
+		run = min(run, nextBoost-totalTime);
+		if(windows)
+		{
+			int queued = 0;
+			for(int l=0; l<levels; l++) queued += ready[l].size();
+			recordSpan(windows, totalTime, run, true, queued);
+		}
+		cpu.b.p.burst -= run;
+		cpu.used += run;
+		totalTime += run;
+		int ioBurst;
+		if(cpu.b.p.burst==0 && startIo(cpu.b.p, ioTable, ioBurst)) //if an i/o burst follows the cpu burst, block the process until it completes
+		{
+			/* it keeps its level and the time used there, unless the quantum is used up or a boost comes first */
+			if(cpu.used==levelQuantum)
+			{
+				if(cpu.level<levels-1) cpu.level++;
+				cpu.used = 0;
+			}
+			if(totalTime+ioBurst>=nextBoost)
+			{
+				cpu.level = 0;
+				cpu.used = 0;
+			}
+			/**/
+			blocked.push(make_pair(make_pair((long long)totalTime+ioBurst, (long long)totalTime), cpu));
+			running = false;
+		}
+		else if(cpu.b.p.burst==0) //if the process is finished, save its timing stats
+		{
+			cpu.b.s.turnAround = totalTime - cpu.b.p.arrival;
+			cpu.b.s.waiting = cpu.b.s.turnAround - cpu.burst;
+			pStats.push_back(cpu.b.s);
+			if(windows) recordCompletion(windows, totalTime, cpu.b.s.waiting);
+			running = false;
+		}
+		else if(cpu.used==levelQuantum) //if the process has used up its quantum, move it down a level
+		{
+			if(cpu.level<levels-1) cpu.level++;
+			cpu.used = 0;
+			expired = true;
+			running = false;
+		}
+		/**/
+	}
+}
+
+/* Function:	edf
+ *    Usage:	int totalTime;
+ *				int idleTime;
+ *				vector<processStats> pStats;
+ *    			edf(ps, ioTable, totalTime, idleTime, pStats);
+ *  -------------------------------------------
+ *  Runs a simulation of the preemptive EDF (earliest deadline first) scheduling algorithm.
+ *  The process with the earliest absolute deadline (arrival + deadline) runs, and an arrival with an earlier
+ *  deadline preempts it. Processes without a deadline run after all processes with one, in arrival order.
+ *  Waiting processes are kept in a heap ordered by deadline, and a process that finishes an i/o burst returns to it
+ *  with the deadline of the whole process. Time advances from event to event (arrival, i/o completion, completion).
+ *  - ps: contains the processes to schedule and execute
+ *  - ioTable: the i/o table of the processes (see workload)
+ *  - totalTime: set to equal the total time of execution
+ *  - idleTime: set to equal the total time the cpu is idle
+ *  - pStats: set to contain the timing statistics for each process
+ *  - windows: if not NULL, records the metrics of each window of simulated time
+ */
+void edf(vector<process> ps, const vector<int> & ioTable, int & totalTime, int & idleTime, vector<processStats> & pStats, windowRecorder * windows)
+{
+	pStats.clear();
+	totalTime = 0;
+	idleTime = 0;
+	vector<processBlock> blocks(ps.size());
+	priority_queue< pair<long long,int>, vector< pair<long long,int> >, greater< pair<long long,int> > > ready; //(absolute deadline, arrival order)
+	timerHeap<int> blocked; //processes waiting for i/o
+	int next = 0;	//the next process to arrive
+	int cpu = -1;	//the process on the cpu, -1 if none
+	long long cpuDeadline = 0;
+	while(cpu>=0 || ready.size()>0 || next<ps.size() || blocked.size()>0)
+	{
+		/* there are no processes ready to run until the next arrival or i/o completion */
+		int event = INT_MAX;
+		if(next<ps.size()) event = ps[next].arrival;
+		if(blocked.size()>0) event = min(event, (int)blocked.top().first.first);
+		if(cpu<0 && ready.size()==0 && totalTime<event)
+		{
+			if(windows) recordSpan(windows, totalTime, event-totalTime, false, 0);
+			idleTime += event - totalTime;
+			totalTime = event;
+		}
+		/**/
+		/* add any arriving processes to the heap */
+		for(; next<ps.size() && ps[next].arrival<=totalTime; next++)
+		{
+			blocks[next] = newProcessBlock(ps[next]);
+			long long deadline = (ps[next].deadline>0) ? (long long)ps[next].arrival+ps[next].deadline : LLONG_MAX;
+			ready.push(make_pair(deadline, next));
+		}
+		/**/
+		/* add any processes finishing i/o back to the heap; the deadline is that of the whole process */
+		for(; blocked.size()>0 && blocked.top().first.first<=totalTime; blocked.pop())
+		{
+			int i = blocked.top().second;
+			long long deadline = (ps[i].deadline>0) ? (long long)ps[i].arrival+ps[i].deadline : LLONG_MAX;
+			ready.push(make_pair(deadline, i));
+		}
+		/**/
+		/* run the process with the earliest deadline, preempting the current process if necessary */
+		if(cpu>=0 && ready.size()>0 && ready.top().first<cpuDeadline)
+		{
+			ready.push(make_pair(cpuDeadline, cpu));
+			cpu = -1;
+		}
+		if(cpu<0)
+		{
+			cpu = ready.top().second;
+			cpuDeadline = ready.top().first;
+			ready.pop();
+		}
+		/**/
+		/* run the current process until its cpu burst finishes or the next process arrives or wakes */
+		processBlock & c = blocks[cpu];
+		int run = c.p.burst;
+		if(next<ps.size()) run = min(run, ps[next].arrival-totalTime);
+		if(blocked.size()>0) run = min(run, (int)blocked.top().first.first-totalTime);
+		if(windows) recordSpan(windows, totalTime, run, true, ready.size());
+		c.p.burst -= run;
+		totalTime += run;
+		int ioBurst;
+		if(c.p.burst==0 && startIo(c.p, ioTable, ioBurst)) //if an i/o burst follows the cpu burst, block the process until it completes
+		{
+			blocked.push(make_pair(make_pair((long long)totalTime+ioBurst, (long long)totalTime), cpu));
+			cpu = -1;
+		}
+		else if(c.p.burst==0) //if the process is finished, save its timing stats
+		{
+			c.s.turnAround = totalTime - c.p.arrival;
+			c.s.waiting = c.s.turnAround - serviceTime(ps[cpu], ioTable);
+			pStats.push_back(c.s);
+			if(windows) recordCompletion(windows, totalTime, c.s.waiting);
+			cpu = -1;
+		}
+		/**/
+	}
+}
+
+/* Function:	simulateSplit
+ *    Usage:	int totalTime;
+ *				int idleTime;
+ *				vector<processStats> pStats;
+ *    			simulateSplit(ps, ioTable, opt, threads, totalTime, idleTime, pStats);
+ *  -------------------------------------------
+ *  Runs the simulation of the scheduling algorithm selected by 'opt' with the same results as simulate, but
+ *  splits the processes into busy periods first. Whenever the system empties out, nothing that happened before
+ *  affects what happens after, so the busy periods are simulated separately (shifted to start at time 0) on
+ *  'threads' threads and their results joined back together.
+ *  Options whose busy periods can not be found without simulating them are simulated in one piece.
+ *  - ps: contains the processes to schedule and execute, sorted by arrival time
+ *  - ioTable: the i/o table of the processes (see workload)
+ *  - opt: the cpu scheduling option to simulate
+ *  - threads: the number of busy periods simulated at the same time
+ *  - totalTime: set to equal the total time of execution
+ *  - idleTime: set to equal the total time the cpu is idle
+ *  - pStats: set to contain the timing statistics for each process
+ */
+void simulateSplit(const vector<process> & ps, const vector<int> & ioTable, const option & opt, int threads, int & totalTime, int & idleTime, vector<processStats> & pStats)
+{
+	vector<int> starts;
+	if(!findBusyPeriods(ps, opt, starts) || starts.size()<2)
+	{
+		simulate(ps, ioTable, opt, totalTime, idleTime, pStats);
+		return;
+	}
+	int periods = (int)starts.size();
+	starts.push_back((int)ps.size());
+	vector<int> periodTotals(periods);
+	vector<int> periodIdles(periods);
+	vector< vector<processStats> > periodStats(periods);
+	/* simulate the busy periods, each thread taking the next one not yet taken */
+	atomic<int> nextPeriod(0);
+	vector<thread> pool;
+	for(int t=0; t<min(threads, periods); t++)
+	{
+		pool.push_back(thread([&]()
+		{
+			for(int i=nextPeriod++; i<periods; i=nextPeriod++)
+			{
+				vector<process> period(ps.begin()+starts[i], ps.begin()+starts[i+1]);
+				int shift = period[0].arrival;
+				for(int j=0; j<period.size(); j++) period[j].arrival -= shift;
+				simulate(period, ioTable, opt, periodTotals[i], periodIdles[i], periodStats[i]);
+			}
+		}));
+	}
+	for(int t=0; t<pool.size(); t++) pool[t].join();
+	/**/
+	/* join the busy periods; the cpu is idle between them */
+	pStats.clear();
+	int busyTime = 0;
+	idleTime = 0;
+	for(int i=0; i<periods; i++)
+	{
+		pStats.insert(pStats.end(), periodStats[i].begin(), periodStats[i].end());
+		busyTime += periodTotals[i];
+		idleTime += periodIdles[i];
+	}
+	totalTime = ps[starts[periods-1]].arrival + periodTotals[periods-1];
+	idleTime += totalTime - busyTime;
+	/**/
+}
+
+/* Function:	findBusyPeriods
+ *    Usage:	vector<int> starts;
+ *				if(findBusyPeriods(ps, opt, starts)) ...
+ *  -------------------------------------------
+ *  Finds where the system empties out under the option in a single scan of the processes, setting 'starts' to
+ *  the index in 'ps' of the first process of each busy period.
+ *  The cpu never sits idle while processes are waiting, so a busy period lasts as long as the work arriving in it:
+ *  the processes' bursts plus a context switch each time one is swapped in. For RR and RRP the number of
+ *  times a process is swapped in depends only on its burst. For CFS and MLFQ it depends on the schedule, so they
+ *  can only be split without context switch time, and an MLFQ priority boost ties it to absolute time.
+ *  Processes with i/o bursts leave the cpu idle while they are blocked, so they can not be split either.
+ *  Returns false if the option can not be split.
+ */
+bool findBusyPeriods(const vector<process> & ps, const option & opt, vector<int> & starts)
+{
+	starts.clear();
+	if((opt.alg==CFS || opt.alg==MLFQ) && opt.switchTime>0) return false;
+	if(opt.alg==MLFQ && opt.boostPeriod>0) return false;
+	if(hasIo(ps)) return false;
+	long long end = 0; //when the current busy period ends
+	for(int i=0; i<ps.size(); i++)
+	{
+		long long switching = (opt.alg==RR || opt.alg==RRP) ? swapsIn(ps[i].burst, opt)*opt.switchTime : 0;
+		if(i==0 || ps[i].arrival>=end)
+		{
+			starts.push_back(i);
+			end = ps[i].arrival;
+		}
+		end += ps[i].burst + switching;
+	}
+	return true;
+}
+
+/* Function:	swapsIn
+ *    Usage:	long long switching = swapsIn(p.burst, opt)*opt.switchTime;
+ *  -------------------------------------------
+ *  Returns the number of times a process with the cpu burst is swapped in under an RR or RRP option, which
+ *  depends only on the burst (see findBusyPeriods). Returns 1 for the other algorithms, the fewest possible.
+ */
+long long swapsIn(int burst, const option & opt)
+{
+	if(opt.alg==RR) return (burst + opt.slice - 1)/opt.slice;
+	if(opt.alg==RRP && burst>opt.prioritySlice && burst>opt.slice)
+		return 1 + (burst - max(opt.prioritySlice, opt.slice) + opt.slice - 1)/opt.slice;
+	return 1;
+}
+
+/* Function:	rrLockstep
+ *    Usage:	vector<int> totalTimes;
+ *				vector<int> idleTimes;
+ *				vector< vector<processStats> > pStats;
+ *    			rrLockstep(ps, opts, totalTimes, idleTimes, pStats);
+ *  -------------------------------------------
+ *  Runs the simulations of many RR and RRP options side by side, advancing every option (lane) one time unit at a time
+ *  over a single pass through the processes. Each arrival is read once and handed to every lane.
+ *  Produces the same results as running rr and rrp on each option: since a process is either on the cpu or in the
+ *  ready queue from its arrival until it finishes, its stats are computed when it finishes instead of being
+ *  incremented every time unit, so each lane does a constant amount of work per time unit.
+ *  The per lane state is kept in parallel arrays indexed by lane.
+ *  - ps: contains the processes to schedule and execute, sorted by arrival time
+ *  - opts: the RR and RRP options to simulate
+ *  - totalTimes: set to contain the total time of execution of each option
+ *  - idleTimes: set to contain the total time the cpu is idle for each option
+ *  - pStats: set to contain the timing statistics for each process for each option
+ */
+void rrLockstep(const vector<process> & ps, const vector<option> & opts, vector<int> & totalTimes, vector<int> & idleTimes, vector< vector<processStats> > & pStats)
+{
+	int lanes = (int)opts.size();
+	totalTimes.assign(lanes, 0);
+	idleTimes.assign(lanes, 0);
+	pStats.assign(lanes, vector<processStats>());
+	/* lane configuration */
+	vector<int> slice(lanes);
+	vector<int> prioritySlice(lanes);
+	vector<int> switchTime(lanes);
+	for(int l=0; l<lanes; l++)
+	{
+		slice[l] = opts[l].slice;
+		prioritySlice[l] = (opts[l].alg==RRP) ? opts[l].prioritySlice : 0; //an RR lane never gives priority
+		switchTime[l] = opts[l].switchTime;
+		pStats[l].reserve(ps.size());
+	}
+	/**/
+	/* lane state */
+	vector< deque<laneJob> > ready(lanes);
+	vector<laneJob> cpu(lanes);
+	vector<char> running(lanes, false);
+	vector<char> preempted(lanes, false);	//the job on the cpu used up its slice and goes to the back of the ready queue
+	vector<int> switchLeft(lanes, -1);		//time left in the current context switch, -1 if not switching
+	vector<int> timeRunning(lanes, 0);
+	vector<int> currentSlice(lanes, 0);
+	vector<char> done(lanes, ps.size()==0);
+	/**/
+	int lanesLeft = (ps.size()==0) ? 0 : lanes;
+	int next = 0; //the next process to arrive
+	int totalTime = 0;
+	while(lanesLeft>0)
+	{
+		/* find the processes arriving now; they are shared by every lane */
+		int firstArrival = next;
+		while(next<ps.size() && ps[next].arrival==totalTime) next++;
+		/**/
+		bool allIdle = true; //no lane has work left until the next arrival
+		for(int l=0; l<lanes; l++)
+		{
+			if(done[l]) continue;
+			/* add any arriving processes to the end of the ready queue, ahead of a preempted process */
+			for(int a=firstArrival; a<next; a++)
+			{
+				laneJob j;
+				j.index = a;
+				j.remaining = ps[a].burst;
+				ready[l].push_back(j);
+			}
+			if(preempted[l])
+			{
+				ready[l].push_back(cpu[l]);
+				preempted[l] = false;
+			}
+			/**/
+			if(!running[l])
+			{
+				/* the cpu is idle and there are no processes currently in the lane */
+				if(switchLeft[l]<0 && ready[l].size()==0)
+				{
+					idleTimes[l]++;
+					continue;
+				}
+				/**/
+				allIdle = false;
+				/* perform the context switch before swapping in the next process */
+				if(switchLeft[l]<0) switchLeft[l] = switchTime[l];
+				if(switchLeft[l]>0)
+				{
+					switchLeft[l]--;
+					idleTimes[l]++;
+					continue;
+				}
+				/**/
+				switchLeft[l] = -1;
+				cpu[l] = ready[l].front();
+				ready[l].pop_front();
+				running[l] = true;
+				timeRunning[l] = 0;
+				/* give the process priority if it is eligible */
+				if(cpu[l].remaining <= prioritySlice[l]) currentSlice[l] = cpu[l].remaining;
+				else currentSlice[l] = slice[l];
+				/**/
+			}
+			allIdle = false;
+			/* run the current process for 1 time unit */
+			cpu[l].remaining--;
+			timeRunning[l]++;
+			if(cpu[l].remaining==0) //if the process is finished, save its timing stats
+			{
+				processStats st;
+				st.turnAround = totalTime + 1 - ps[cpu[l].index].arrival;
+				st.waiting = st.turnAround - ps[cpu[l].index].burst;
+				st.deadline = ps[cpu[l].index].deadline;
+				pStats[l].push_back(st);
+				running[l] = false;
+				if(pStats[l].size()==ps.size())
+				{
+					totalTimes[l] = totalTime + 1;
+					done[l] = true;
+					lanesLeft--;
+				}
+			}
+			else if(timeRunning[l]==currentSlice[l]) //if the process has used up its time slice, preempt it
+			{
+				preempted[l] = true;
+				running[l] = false;
+			}
+			/**/
+		}
+		totalTime++;
+		/* skip ahead to the next arrival when every lane is idle */
+		if(allIdle && next<ps.size() && ps[next].arrival>totalTime)
+		{
+			int skip = ps[next].arrival - totalTime;
+			for(int l=0; l<lanes; l++)
+			{
+				if(!done[l]) idleTimes[l] += skip;
+			}
+			totalTime = ps[next].arrival;
+		}
+		/**/
+	}
+}
+
+/* Function:	startWindows
+ *    Usage:	startWindows(windows, "RR-50/10");
+ *				simulate(ps, ioTable, opt, totalTime, idleTime, pStats, windows);
+ *				flushWindows(windows);
+ *  -------------------------------------------
+ *  Clears the recorder for a new simulation and writes the title and column headings of its windows.
+ */
+void startWindows(windowRecorder * windows, const string & title)
+{
+	windows->first = 0;
+	windows->count = 0;
+	int w = 14; //column width
+	ostream & out = *windows->out;
+	out << left << endl << title << " (windows of " << windows->length << ")" << endl;
+	out << setw(w) << "Window" << setw(w) << "CPU" << setw(w) << "Mean Ready" << setw(w) << "" << setw(w) << "Mean" << setw(w) << "p99" << endl;
+	out << setw(w) << "Start" << setw(w) << "Util. %" << setw(w) << "Queue Length" << setw(w) << "Completions" << setw(w) << "Waiting Time" << setw(w) << "Waiting Time" << endl;
+	for(int i=0; i<6*w-2; i++) out << "="; //insert a line of the appropriate length
+	out << endl;
+}
+
+/* Function:	recordSpan
+ *    Usage:	if(windows) recordSpan(windows, totalTime, 1, true, ready.size());
+ *  -------------------------------------------
+ *  Records a span of simulated time [start, start+length) during which the cpu was busy running a process (or not)
+ *  and 'readyLength' processes were waiting. The span is split between the windows it overlaps.
+ *  Spans must be recorded in time order.
+ */
+void recordSpan(windowRecorder * windows, long long start, long long length, bool busy, int readyLength)
+{
+	while(length>0)
+	{
+		long long index = start/windows->length;
+		long long part = min(length, (index+1)*windows->length - start);
+		windowStats & win = currentWindow(windows, index);
+		win.covered += part;
+		if(busy) win.busyTime += part;
+		win.readyArea += part*readyLength;
+		start += part;
+		length -= part;
+	}
+}
+
+/* Function:	recordCompletion
+ *    Usage:	if(windows) recordCompletion(windows, totalTime, cpu.s.waiting);
+ *  -------------------------------------------
+ *  Records a process finishing at 'time' (the end of its last time unit) after waiting 'waiting' in total.
+ */
+void recordCompletion(windowRecorder * windows, long long time, int waiting)
+{
+	windowStats & win = currentWindow(windows, max(0LL, time-1)/windows->length);
+	win.completions++;
+	win.totalWaiting += waiting;
+	win.waitingHistogram[waitingBucket(waiting)]++;
+}
+
+/* Function:	currentWindow
+ *    Usage:	windowStats & win = currentWindow(windows, index);
+ *  -------------------------------------------
+ *  Returns the window with the given index, opening it (and any window skipped before it) if it is newer than
+ *  the newest window kept. Opening a window when the ring buffer is full writes out the oldest one.
+ */
+windowStats & currentWindow(windowRecorder * windows, long long index)
+{
+	while(windows->count==0 || windows->ring[(windows->first+windows->count-1)%WINDOW_RING].index<index)
+	{
+		long long nextIndex = (windows->count==0) ? index : windows->ring[(windows->first+windows->count-1)%WINDOW_RING].index+1;
+		/* make room by writing out the oldest window */
+		if(windows->count==WINDOW_RING)
+		{
+			writeWindow(windows, windows->ring[windows->first]);
+			windows->first = (windows->first+1)%WINDOW_RING;
+			windows->count--;
+		}
+		/**/
+		windowStats & win = windows->ring[(windows->first+windows->count)%WINDOW_RING];
+		win = windowStats();
+		win.index = nextIndex;
+		windows->count++;
+	}
+	return windows->ring[(windows->first+windows->count-1)%WINDOW_RING];
+}
+
+/* Function:	writeWindow
+ *    Usage:	writeWindow(windows, win);
+ *  -------------------------------------------
+ *  Writes a line with the metrics of a window. The p99 waiting time is the upper end of the histogram bucket
+ *  it falls in, at most 1/16th above the true value.
+ */
+void writeWindow(windowRecorder * windows, const windowStats & win)
+{
+	int w = 14; //column width
+	double covered = max(win.covered, 1LL);
+	double meanWaiting = (win.completions>0) ? (double)win.totalWaiting/win.completions : 0;
+	/* find the bucket holding the 99th percentile */
+	long long p99 = 0;
+	int rank = (int)ceil(0.99*win.completions);
+	for(int b=0, seen=0; b<WAITING_BUCKETS && rank>0; b++)
+	{
+		seen += win.waitingHistogram[b];
+		if(seen>=rank)
+		{
+			if(b<16) p99 = b;
+			else p99 = ((long long)(16+(b-16)%16+1) << ((b-16)/16)) - 1;
+			break;
+		}
+	}
+	/**/
+	ostream & out = *windows->out;
+	out << left << fixed << setprecision(2) << setw(w) << win.index*windows->length << setw(w) << win.busyTime/covered*100
+		<< setw(w) << win.readyArea/covered << setw(w) << win.completions << setw(w) << meanWaiting << p99 << endl;
+}
+
+/* Function:	flushWindows
+ *    Usage:	flushWindows(windows);
+ *  -------------------------------------------
+ *  Writes out every window still kept in the ring buffer, oldest first.
+ */
+void flushWindows(windowRecorder * windows)
+{
+	for(int i=0; i<windows->count; i++) writeWindow(windows, windows->ring[(windows->first+i)%WINDOW_RING]);
+	windows->first = 0;
+	windows->count = 0;
+}
+
+/* Function:	waitingBucket
+ *    Usage:	win.waitingHistogram[waitingBucket(waiting)]++;
+ *  -------------------------------------------
+ *  Returns the histogram bucket of a waiting time: values below 16 have their own bucket, and each power of two
+ *  above that is split into 16 buckets, so a bucket is never wider than 1/16th of its values.
+ */
+int waitingBucket(int waiting)
+{
+	if(waiting<16) return max(waiting, 0);
+	int e = 31 - __builtin_clz(waiting); //position of the highest set bit, at least 4
+	return 16 + (e-4)*16 + ((waiting >> (e-4)) & 15);
+}
+
+/* Function:	addProcessByArrival
+ *    Usage:	vector<process> ps 
+ *				addProcessByArrival(p, ps);
+ * -------------------------------------------
+ * Adds the process in the apporpriate position in the vector, 
+ * keeps it sorted by arrival time from least to greatest.
+ */
+void addProcessByArrival(process & p,  vector<process> & ps)
+{
+	if(ps.size()==0 || p.arrival >= ps.back().arrival )
+		ps.push_back(p);
+	else 
+	{
+		int i = (int)ps.size()-1;
+		ps.resize(ps.size()+1);
+		do
+		{
+			ps[i+1] = ps[i];
+			i--;
+		} while(i>=0 && p.arrival<ps[i].arrival);
+		ps[i+1] = p;
+	}
+}
+
+/* Function:	addProcessBlockByBurst
+ *    Usage:	deque<processBlock> p 
+ *				addProcessBlockByBurst(b, bs);
+ *  -------------------------------------------
+ *  Adds the processBlock in the apporpriate position in the vector, 
+ *  keeps it sorted by the processescpu burst time from least to greatest.
+ */
+void addProcessBlockByBurst(processBlock & b, deque<processBlock> & bs)
+{
+	if(bs.size()==0 || b.p.burst >= bs.back().p.burst )
+		bs.push_back(b);
+	else 
+	{
+		int i = (int)bs.size()-1;
+		bs.resize(bs.size()+1);
+		do
+		{
+			bs[i+1] = bs[i];
+			i--;
+		} while(i>=0 && b.p.burst<bs[i].p.burst);
+		bs[i+1] = b;
+	}
+}
+
+/* Function:	newProcessBlock
+ *    Usage:	processBlock b = newProcessBlock(ps[0]);
+ *  -------------------------------------------
+ *  Returns a new 'processBlock' for the process, with its stats initialized.
+ */
+processBlock newProcessBlock(const process & p)
+{
+	processBlock b;
+	b.p = p;
+	b.s = processStats();
+	b.s.deadline = p.deadline;
+	return b;
+}
+
+/* Function:	addNewArrivals
+ *    Usage:	deque<processBlock> bs
+ *				addNewArrivals(ps, ready);
+ *  -------------------------------------------
+ *  For all processes in 'ps' that have the same arrival time as 'ps[0]', 
+ *  a new 'processBlock' is created, initialized, and inserted at the end of 'ready'.
+ */
+void addNewArrivals(vector<process> & ps, deque<processBlock> & ready)
+{
+	int arrive = ps[0].arrival;
+	do
+	{
+		processBlock b = newProcessBlock(ps[0]);
+		ready.push_back(b);
+		ps.erase(ps.begin());
+	} while(ps.size()>0 && ps[0].arrival==arrive);
+}
+
+/* Function:	addNewArrivalsInOrder
+ *    Usage:	deque<processBlock> bs
+ *				addNewArrivalsInOrder(ps, ready);
+ *  -------------------------------------------
+ *  For all processes in 'ps' that have the same arrival time as 'ps[0]', 
+ *  a new 'processBlock' is created, initialized, and inserted at the correct position in 'ready'.
+ */
+void addNewArrivalsInOrder(vector<process> & ps, deque<processBlock> & ready)
+{
+	int arrive = ps[0].arrival;
+	do
+	{
+		processBlock b = newProcessBlock(ps[0]);
+		addProcessBlockByBurst(b, ready);
+		ps.erase(ps.begin());
+	} while(ps.size()>0 && ps[0].arrival==arrive);
+}
+
+/* Function:	startIo
+ *    Usage:	int ioBurst;
+ *				if(p.burst==0 && startIo(p, ioTable, ioBurst)) ...
+ *  -------------------------------------------
+ *  Moves a process that has finished its cpu burst on to its next i/o burst: sets 'ioBurst' to the length of the
+ *  i/o burst and 'p.burst' to the cpu burst that follows it. Returns false if the process is finished instead.
+ */
+bool startIo(process & p, const vector<int> & ioTable, int & ioBurst)
+{
+	if(p.io==0 || ioTable[p.io]==0) return false;
+	ioBurst = ioTable[p.io];
+	p.burst = ioTable[p.io+1];
+	p.io += 2;
+	return true;
+}
+
+/* Function:	serviceTime
+ *    Usage:	c.s.waiting = c.s.turnAround - serviceTime(ps[i], ioTable);
+ *  -------------------------------------------
+ *  Returns the total length of a process' cpu and i/o bursts, the part of its turnaround time not spent waiting.
+ */
+int serviceTime(const process & p, const vector<int> & ioTable)
+{
+	int total = p.burst;
+	for(int i=p.io; i>0 && ioTable[i]>0; i++) total += ioTable[i];
+	return total;
+}
+
+/* Function:	blockOnIo
+ *    Usage:	if(cpu.p.burst==0 && blockOnIo(cpu, ioTable, totalTime, blocked)) ...
+ *  -------------------------------------------
+ *  If an i/o burst follows the cpu burst the process just finished, moves the process into 'blocked' until the
+ *  i/o completes and returns true. Its turnaround time is advanced by the length of the i/o burst up front,
+ *  since the time unit schedulers only count it while the process is in the ready queue or on the cpu.
+ */
+bool blockOnIo(processBlock & b, const vector<int> & ioTable, long long time, timerHeap<processBlock> & blocked)
+{
+	int ioBurst;
+	if(!startIo(b.p, ioTable, ioBurst)) return false;
+	b.s.turnAround += ioBurst;
+	blocked.push(make_pair(make_pair(time+ioBurst, time), b));
+	return true;
+}
+
+/* Function:	addWakeUps
+ *    Usage:	addWakeUps(blocked, totalTime, ready);
+ *  -------------------------------------------
+ *  Moves every process in 'blocked' whose i/o has completed by 'time' to the end of 'ready', in the order they woke.
+ */
+void addWakeUps(timerHeap<processBlock> & blocked, long long time, deque<processBlock> & ready)
+{
+	for(; blocked.size()>0 && blocked.top().first.first<=time; blocked.pop()) ready.push_back(blocked.top().second);
+}
+
+/* Function:	addWakeUpsInOrder
+ *    Usage:	addWakeUpsInOrder(blocked, totalTime, ready);
+ *  -------------------------------------------
+ *  Moves every process in 'blocked' whose i/o has completed by 'time' to the correct position in 'ready'.
+ */
+void addWakeUpsInOrder(timerHeap<processBlock> & blocked, long long time, deque<processBlock> & ready)
+{
+	for(; blocked.size()>0 && blocked.top().first.first<=time; blocked.pop())
+	{
+		processBlock b = blocked.top().second;
+		addProcessBlockByBurst(b, ready);
+	}
+}
+
+/* Function:	nextEvent
+ *    Usage:	if(totalTime<nextEvent(ps, blocked)) ...
+ *  -------------------------------------------
+ *  Returns the time of the next arrival in 'ps' or i/o completion in 'blocked', whichever comes first
+ *  (LLONG_MAX if there are neither).
+ */
+long long nextEvent(const vector<process> & ps, const timerHeap<processBlock> & blocked)
+{
+	long long event = (ps.size()>0) ? ps[0].arrival : LLONG_MAX;
+	if(blocked.size()>0) event = min(event, blocked.top().first.first);
+	return event;
+}
+
+/* Function:	hasIo
+ *    Usage:	if(hasIo(ps)) ...
+ *  -------------------------------------------
+ *  Returns true if any of the processes has an i/o burst.
+ */
+bool hasIo(const vector<process> & ps)
+{
+	for(int i=0; i<ps.size(); i++)
+	{
+		if(ps[i].io) return true;
+	}
+	return false;
+}
+
+/* Function:	optimize
+ *    Usage:	optimizer o;
+ *				readInOptimizer(argc, argv, ps, ioTable, o);
+ *    			optimize(ps, ioTable, o);
+ *  -------------------------------------------
+ *  Searches the slice (RR) or slice and priority slice (RRP) of a scheduling option for
+ *  the configuration that minimizes the chosen objective, then prints its report.
+ *  If no configuration reaches the utilization floor, the report says so and shows the one closest to it.
+ *  Each parameter is found with a golden-section search over a logarithmic scale from 1 to the longest
+ *  burst (larger slices behave identically). RRP alternates between the two parameters until neither improves.
+ *  - ps: contains the processes to schedule and execute
+ *  - ioTable: the i/o table of the processes (see workload)
+ *  - o: the search settings; on return holds every simulated configuration and the simulation count
+ */
+void optimize(const vector<process> & ps, const vector<int> & ioTable, optimizer & o)
+{
+	int slice = 1;
+	int prioritySlice = 0;
+	if(o.alg==RR)
+	{
+		slice = goldenSectionSearch(ps, ioTable, o, 1, o.maxSlice, slice, prioritySlice, false);
+	}
+	else
+	{
+		/* coordinate descent: alternate the searched parameter until a round brings no improvement */
+		prioritySlice = o.maxSlice/2;
+		double best = score(ps, ioTable, o, slice, prioritySlice);
+		for(int round=0; round<8; round++)
+		{
+			slice = goldenSectionSearch(ps, ioTable, o, 1, o.maxSlice, slice, prioritySlice, false);
+			prioritySlice = goldenSectionSearch(ps, ioTable, o, 1, o.maxSlice, slice, prioritySlice, true);
+			double current = score(ps, ioTable, o, slice, prioritySlice);
+			if(current >= best) break;
+			best = current;
+		}
+		/**/
+	}
+	/* report the best configuration */
+	option opt;
+	opt.alg = o.alg;
+	opt.slice = slice;
+	opt.prioritySlice = prioritySlice;
+	opt.switchTime = o.switchTime;
+	vector<option> opts(1, opt);
+	vector< vector<processStats> > pStats(1, vector<processStats>());
+	vector<int> totalTimes(1, 0);
+	vector<int> idleTimes(1, 0);
+	simulate(ps, ioTable, opt, totalTimes[0], idleTimes[0], pStats[0]);
+	double gridSize = (o.alg==RR) ? o.maxSlice : (double)o.maxSlice*o.maxSlice;
+	stringstream floor;
+	floor << o.utilizationFloor;
+	const string GOAL[3] = {"average turnaround time", "p99 waiting time", "average turnaround time with utilization >= " + floor.str() + "%"};
+	cout << "Optimized " << ALGORITHM[o.alg] << " for " << GOAL[o.goal] << " (context switch time " << o.switchTime << ")" << endl;
+	cout << "Simulations: " << o.simulations << " (exhaustive grid: " << fixed << setprecision(0) << gridSize << ")" << endl;
+	optionSummary sum = summarize(pStats[0], totalTimes[0], idleTimes[0]);
+	if(o.goal==P99WAITING) cout << "p99 waiting time: " << setprecision(2) << sum.p99Waiting << endl;
+	if(o.goal==UTILIZATION && sum.cpuUtilization<o.utilizationFloor)
+	{
+		cout << "No configuration searched keeps cpu utilization at or above " << floor.str() << "%; "
+			<< "reporting the one that comes closest (" << setprecision(2) << sum.cpuUtilization << "%)." << endl;
+	}
+	cout << endl;
+	printReport(opts, pStats, totalTimes, idleTimes);
+	/**/
+}
+
+/* Function:	score
+ *    Usage:	double s = score(ps, ioTable, o, slice, prioritySlice);
+ *  -------------------------------------------
+ *  Returns the objective value of a configuration (lower is better), simulating it only if it has not been scored before.
+ *  Under the UTILIZATION objective, configurations below the floor score worse than every configuration above it.
+ */
+double score(const vector<process> & ps, const vector<int> & ioTable, optimizer & o, int slice, int prioritySlice)
+{
+	pair<int,int> key(slice, o.alg==RRP ? prioritySlice : 0);
+	map< pair<int,int>, double >::iterator found = o.scores.find(key);
+	if(found!=o.scores.end()) return found->second;
+
+	option opt;
+	opt.alg = o.alg;
+	opt.slice = key.first;
+	opt.prioritySlice = key.second;
+	opt.switchTime = o.switchTime;
+	int totalTime;
+	int idleTime;
+	vector<processStats> pStats;
+	simulate(ps, ioTable, opt, totalTime, idleTime, pStats);
+	o.simulations++;
+	optionSummary sum = summarize(pStats, totalTime, idleTime);
+	double result = sum.avgTurnAround;
+	if(o.goal==P99WAITING) result = sum.p99Waiting;
+	else if(o.goal==UTILIZATION && sum.cpuUtilization<o.utilizationFloor) result = 1e15 + (o.utilizationFloor-sum.cpuUtilization)*1e12;
+	o.scores[key] = result;
+	return result;
+}
+
+/* Function:	goldenSectionSearch
+ *    Usage:	slice = goldenSectionSearch(ps, ioTable, o, 1, o.maxSlice, slice, prioritySlice, false);
+ *  -------------------------------------------
+ *  Golden-section search over the integers lo..hi on a logarithmic scale for the value of one parameter
+ *  (the slice, or the priority slice if 'searchPriority') that minimizes the objective, the other parameter held fixed.
+ *  Stops early once the best score has not improved by more than 0.1% over 4 consecutive narrowing steps.
+ *  Returns the best value seen.
+ */
+int goldenSectionSearch(const vector<process> & ps, const vector<int> & ioTable, optimizer & o, int lo, int hi, int slice, int prioritySlice, bool searchPriority)
+{
+	const double INVPHI = (sqrt(5.0)-1)/2;
+	const int PATIENCE = 4;
+	int bestValue = searchPriority ? prioritySlice : slice;
+	double best = score(ps, ioTable, o, slice, prioritySlice);
+	double a = log((double)lo);
+	double b = log((double)hi);
+	double c = b - INVPHI*(b-a);
+	double d = a + INVPHI*(b-a);
+	int stalled = 0;
+	double fc = 0, fd = 0;
+	for(int i=0; i<2; i++)
+	{
+		int value = (int)lround(exp(i==0 ? c : d));
+		double f = searchPriority ? score(ps, ioTable, o, slice, value) : score(ps, ioTable, o, value, prioritySlice);
+		if(i==0) fc = f;
+		else fd = f;
+		if(f<best)
+		{
+			best = f;
+			bestValue = value;
+		}
+	}
+	/* narrow the bracket until it holds only a few integers or the score stops improving */
+	while(lround(exp(b))-lround(exp(a))>2 && stalled<PATIENCE)
+	{
+		double x;
+		if(fc<=fd)
+		{
+			b = d;
+			d = c;
+			fd = fc;
+			c = b - INVPHI*(b-a);
+			x = c;
+		}
+		else
+		{
+			a = c;
+			c = d;
+			fc = fd;
+			d = a + INVPHI*(b-a);
+			x = d;
+		}
+		int value = (int)lround(exp(x));
+		double f = searchPriority ? score(ps, ioTable, o, slice, value) : score(ps, ioTable, o, value, prioritySlice);
+		if(x==c) fc = f;
+		else fd = f;
+		if(f < best - 0.001*fabs(best)) stalled = 0;
+		else stalled++;
+		if(f<best)
+		{
+			best = f;
+			bestValue = value;
+		}
+	}
+	/**/
+	/* check the integers left in a collapsed bracket */
+	if(stalled<PATIENCE)
+	{
+		for(long value=lround(exp(a)); value<=lround(exp(b)); value++)
+		{
+			double f = searchPriority ? score(ps, ioTable, o, slice, (int)value) : score(ps, ioTable, o, (int)value, prioritySlice);
+			if(f<best)
+			{
+				best = f;
+				bestValue = (int)value;
+			}
+		}
+	}
+	/**/
+	return bestValue;
+}
+
+/* Function:	optionName
+ *    Usage:	string name = optionName(opt);
+ *  -------------------------------------------
+ *  Returns the S.dat style name of a cpu scheduling option (eg. "FCFS" "RR-100/10" "RRP-100/1000/10" "CFS-24/3/10" "MLFQ-4/50/5000/10").
+ */
+string optionName(const option & opt)
+{
+	string name = ALGORITHM[opt.alg];
+	if(opt.alg==RR) name += "-" + to_string(opt.slice) + "/" + to_string(opt.switchTime);
+	if(opt.alg==RRP) name += "-" + to_string(opt.slice) + "/" + to_string(opt.prioritySlice) + "/" + to_string(opt.switchTime);
+	if(opt.alg==CFS) name += "-" + to_string(opt.latency) + "/" + to_string(opt.granularity) + "/" + to_string(opt.switchTime);
+	if(opt.alg==MLFQ) name += "-" + to_string(opt.levels) + "/" + to_string(opt.slice) + "/" + to_string(opt.boostPeriod) + "/" + to_string(opt.switchTime);
+	return name;
+}
+
+/* Function:	summarize
+ *    Usage:	optionSummary sum = summarize(pStats, totalTime, idleTime);
+ *  -------------------------------------------
+ *  Computes the averages, p99 waiting time, cpu utilization and number of missed deadlines of a simulated cpu scheduling option.
+ */
+optionSummary summarize(const vector<processStats> & pStats, int totalTime, int idleTime)
+{
+	optionSummary sum;
+	double totalTurnAround=0;
+	double totalWaiting=0;
+	vector<int> waiting(pStats.size());
+	sum.deadlineMisses = 0;
+	for(int j = 0; j<pStats.size(); j++)
+	{
+		totalTurnAround += pStats[j].turnAround;
+		totalWaiting += pStats[j].waiting;
+		waiting[j] = pStats[j].waiting;
+		if(pStats[j].deadline>0 && pStats[j].turnAround>pStats[j].deadline) sum.deadlineMisses++;
+	}
+	sum.avgTurnAround = totalTurnAround/pStats.size();
+	sum.avgWaiting = totalWaiting/pStats.size();
+	sum.p99Waiting = percentile(waiting, 0.99);
+	sum.cpuUtilization = ( (totalTime-idleTime)/(double)totalTime ) * 100;
+	return sum;
+}
+
+/* Function:	percentile
+ *    Usage:	double p99 = percentile(values, 0.99);
+ *  -------------------------------------------
+ *  Returns the nearest-rank percentile of 'values' ('fraction' between 0 and 1), or 0 if there are no values.
+ */
+double percentile(vector<int> values, double fraction)
+{
+	if(values.size()==0) return 0;
+	int rank = (int)ceil(fraction*values.size());
+	if(rank<1) rank = 1;
+	nth_element(values.begin(), values.begin()+rank-1, values.end());
+	return values[rank-1];
+}
+
+/* Function:	steadyState
+ *    Usage:	steadyEstimate e = steadyState(opt, settings);
+ *  -------------------------------------------
+ *  Estimates the steady state mean turnaround time of an option under an open workload with exponentially
+ *  distributed interarrival and burst times. The warm-up transient is found with MSER-5 and discarded, and a
+ *  95% confidence interval is built from batch means of the rest.
+ *  The run is extended one busy period at a time: whenever the system empties out nothing that happened before
+ *  affects what happens after, so each busy period is simulated on its own (shifted to start at time 0) and its
+ *  processes appended to the output. The interval is tested each time the output grows by a quarter, and the run
+ *  stops as soon as the half width is within the tolerance (or settings.maxJobs processes have finished).
+ *  The simulated end of a busy period is checked against the next arrival, since context switches can make
+ *  a busy period last longer than its processes' bursts; if they overlap the busy period is extended.
+ *  An option whose expected load is 1 or more has no steady state (its first busy period never ends), so it is
+ *  not simulated; see steadyLoad. A busy period is also cut short once the run reaches settings.maxJobs
+ *  processes or the longest time a simulation can count, and the estimate is then reported as not converged.
+ */
+steadyEstimate steadyState(const option & opt, const steadySettings & settings)
+{
+	steadyEstimate e = steadyEstimate();
+	e.load = steadyLoad(opt, settings);
+	if(e.load>=1) return e;
+	workloadGenerator g;
+	startGenerator(g, settings);
+	vector<double> turnAround;
+	vector<double> waiting;
+	int nextBurst;
+	long long nextArrival = generateProcess(g, nextBurst);
+	size_t nextCheck = 1000;
+	while(true)
+	{
+		/* take the processes of the next busy period */
+		long long start = nextArrival;
+		if(opt.alg==MLFQ && opt.boostPeriod>0) start -= start%opt.boostPeriod; //keep the priority boosts at the same times
+		long long end = nextArrival; //when the work arrived so far is done, ignoring context switches at first
+		vector<process> period;
+		vector<processStats> pStats;
+		bool capped = false; //the busy period was cut short
+		while(true)
+		{
+			while(period.size()==0 || (nextArrival<end && !capped))
+			{
+				process pr = process();
+				pr.arrival = (int)(nextArrival-start);
+				pr.burst = nextBurst;
+				period.push_back(pr);
+				end = max(end, nextArrival) + nextBurst;
+				nextArrival = generateProcess(g, nextBurst);
+				capped = turnAround.size()+period.size()>=settings.maxJobs || end-start>=INT_MAX/4;
+			}
+			int totalTime;
+			int idleTime;
+			simulate(period, vector<int>(), opt, totalTime, idleTime, pStats); //generated processes do no i/o
+			if(capped || start+totalTime<=nextArrival) break;
+			end = start+totalTime; //context switches ran the busy period into the next arrival
+			capped = end-start>=INT_MAX/4;
+		}
+		for(int i=0; i<pStats.size(); i++)
+		{
+			turnAround.push_back(pStats[i].turnAround);
+			waiting.push_back(pStats[i].waiting);
+		}
+		/**/
+		if(turnAround.size()<nextCheck && !capped) continue;
+		nextCheck = turnAround.size() + turnAround.size()/4;
+		/* discard the warm-up and estimate the mean of the rest */
+		e.jobs = (int)turnAround.size();
+		e.warmUp = mser5(turnAround);
+		batchMeans(turnAround, e.warmUp, e.mean, e.halfWidth);
+		double unused;
+		batchMeans(waiting, e.warmUp, e.meanWaiting, unused);
+		/**/
+		/* a warm-up reaching the end of the range MSER-5 searches means the run is still in the transient */
+		bool settled = e.warmUp < (int)turnAround.size()/2 - 5;
+		e.converged = !capped && settled && e.halfWidth <= settings.tolerance*e.mean;
+		if(e.converged || capped) return e;
+		/**/
+	}
+}
+
+/* Function:	steadyLoad
+ *    Usage:	if(steadyLoad(opt, settings)>=1) ...
+ *  -------------------------------------------
+ *  Returns the expected fraction of the time the cpu is busy under the option: the mean cpu burst, as rounded by
+ *  generateProcess, plus the mean context switch time spent swapping a process in, over the mean interarrival time.
+ *  A process is swapped in as often as swapsIn counts; for CFS and MLFQ that is a lower bound.
+ */
+double steadyLoad(const option & opt, const steadySettings & settings)
+{
+	double work = 0;
+	double below = 0; //probability of a burst shorter than k+0.5 (a burst of k or less)
+	for(int k=1; 1-below>1e-12 && k<INT_MAX; k++)
+	{
+		double upTo = 1 - exp(-(k+0.5)/settings.meanBurst);
+		long long switching = (opt.alg==RR || opt.alg==RRP || opt.alg==CFS || opt.alg==MLFQ) ? swapsIn(k, opt)*opt.switchTime : 0;
+		work += (upTo-below)*(k + switching);
+		below = upTo;
+	}
+	return work/settings.meanInterarrival;
+}
+
+/* Function:	startGenerator
+ *    Usage:	workloadGenerator g;
+ *				startGenerator(g, settings);
+ *  -------------------------------------------
+ *  Sets up a generator of processes whose interarrival and burst times are exponentially distributed
+ *  (a Poisson arrival process) with the means in 'settings'. The same seed always produces the same processes.
+ */
+void startGenerator(workloadGenerator & g, const steadySettings & settings)
+{
+	g.random.seed(settings.seed);
+	g.interarrival = exponential_distribution<double>(1/settings.meanInterarrival);
+	g.burst = exponential_distribution<double>(1/settings.meanBurst);
+	g.arrival = 0;
+}
+
+/* Function:	generateProcess
+ *    Usage:	int burst;
+ *				long long arrival = generateProcess(g, burst);
+ *  -------------------------------------------
+ *  Draws the next process: sets 'burst' to its cpu burst and returns its arrival time,
+ *  both rounded to whole time units with bursts of at least 1.
+ */
+long long generateProcess(workloadGenerator & g, int & burst)
+{
+	long long arrival = (long long)g.arrival;
+	burst = max(1, (int)lround(g.burst(g.random)));
+	g.arrival += g.interarrival(g.random);
+	return arrival;
+}
+
+/* Function:	mser5
+ *    Usage:	int warmUp = mser5(values);
+ *  -------------------------------------------
+ *  Returns the number of leading values to discard as the warm-up transient, by the MSER-5 rule: the values are
+ *  averaged in batches of 5, and the truncation point d (in batches, searched over the first half) minimizes
+ *  the variance of the remaining batch means divided by their count. Uses suffix sums, so it runs in O(n).
+ */
+int mser5(const vector<double> & values)
+{
+	int m = (int)values.size()/5;
+	if(m<2) return 0;
+	vector<double> z(m);
+	for(int j=0; j<m; j++) z[j] = (values[5*j]+values[5*j+1]+values[5*j+2]+values[5*j+3]+values[5*j+4])/5;
+	/* suffix sums of the batch means and their squares */
+	vector<double> sum(m+1, 0);
+	vector<double> sumSquares(m+1, 0);
+	for(int j=m-1; j>=0; j--)
+	{
+		sum[j] = sum[j+1] + z[j];
+		sumSquares[j] = sumSquares[j+1] + z[j]*z[j];
+	}
+	/**/
+	int best = 0;
+	double bestStatistic = -1;
+	for(int d=0; d<=m/2; d++)
+	{
+		double k = m-d;
+		double statistic = (sumSquares[d] - sum[d]*sum[d]/k)/(k*k);
+		if(bestStatistic<0 || statistic<bestStatistic)
+		{
+			bestStatistic = statistic;
+			best = d;
+		}
+	}
+	return 5*best;
+}
+
+/* Function:	batchMeans
+ *    Usage:	double mean, halfWidth;
+ *				batchMeans(values, warmUp, mean, halfWidth);
+ *  -------------------------------------------
+ *  Computes the mean of values[from..] and the half width of its 95% confidence interval by the method of
+ *  batch means: the values are split into 20 equal batches whose means are treated as independent samples.
+ *  Values left over after the last whole batch count toward the mean but not the interval.
+ */
+void batchMeans(const vector<double> & values, int from, double & mean, double & halfWidth)
+{
+	const int BATCHES = 20;
+	const double T_975 = 2.093; //97.5th percentile of Student's t distribution with BATCHES-1 degrees of freedom
+	int n = (int)values.size()-from;
+	mean = 0;
+	halfWidth = 0;
+	if(n<=0) return;
+	for(int i=from; i<values.size(); i++) mean += values[i];
+	mean /= n;
+	int size = n/BATCHES;
+	if(size==0)
+	{
+		halfWidth = HUGE_VAL;
+		return;
+	}
+	double batchMean[BATCHES];
+	double grand = 0;
+	for(int b=0; b<BATCHES; b++)
+	{
+		batchMean[b] = 0;
+		for(int i=0; i<size; i++) batchMean[b] += values[from+b*size+i];
+		batchMean[b] /= size;
+		grand += batchMean[b];
+	}
+	grand /= BATCHES;
+	double variance = 0;
+	for(int b=0; b<BATCHES; b++) variance += (batchMean[b]-grand)*(batchMean[b]-grand);
+	variance /= BATCHES-1;
+	halfWidth = T_975*sqrt(variance/BATCHES);
+}
+
+/* Function:	printSteadyReport
+ *    Usage:	printSteadyReport(opts, estimates);
+ *  -------------------------------------------
+ *  Prints out the steady state estimates of multiple cpu scheduling options.
+ */
+void printSteadyReport(const vector<option> & opts, const vector<steadyEstimate> & estimates)
+{
+	int w = 13; //static column width
+	int ww = 13; //dynamic column width (Scheduler is the dynamic column)
+	for(int i=0; i<opts.size(); i++) ww = max(ww, (int)optionName(opts[i]).length()+2);
+	stringstream ss;
+	ss << left;
+	ss << setw(ww) << "" << setw(w) << "Average" << setw(w) << "95% CI" << setw(w) << "Average" << setw(w) << "Warm-up" << setw(w) << "" << endl;
+	ss << setw(ww) << "" << setw(w) << "Turnaround" << setw(w) << "Half Width" << setw(w) << "CPU Waiting" << setw(w) << "Processes" << setw(w) << "Processes" << endl;
+	ss << setw(ww) << "Scheduler" << setw(w) << "Time" << setw(w) << "" << setw(w) << "Time" << setw(w) << "Discarded" << setw(w) << "Simulated" << endl;
+	for(int i=0; i<ww+5*w-2; i++) ss << "="; //insert a line of the appropriate length
+	ss << endl;
+	for(int i=0; i<opts.size(); i++)
+	{
+		if(estimates[i].load>=1)
+		{
+			ss << fixed << setprecision(3) << setw(ww) << optionName(opts[i]) << "overloaded (expected load " << estimates[i].load
+				<< " with context switches, there is no steady state)" << endl;
+			continue;
+		}
+		ss << fixed << setprecision(2) << setw(ww) << optionName(opts[i]) << setw(w) << estimates[i].mean << setw(w) << estimates[i].halfWidth
+			<< setw(w) << estimates[i].meanWaiting << setw(w) << estimates[i].warmUp << estimates[i].jobs;
+		if(!estimates[i].converged) ss << " (not converged)";
+		ss << endl;
+	}
+	cout << ss.str();
+}
+
+/* Function:	batch
+ *    Usage:	batch("traces/", opts, 2, 8);
+ *				batch("traces/host*.dat", opts, 2, 8);
+ *  -------------------------------------------
+ *  Simulates every trace (a file in the format of P.dat) matching 'pattern' under each option, and prints one
+ *  report of every trace and option. A directory stands for all the files in it.
+ *  Traces are read by 'loaders' threads and simulated by 'simulators' threads as soon as they are loaded, so
+ *  reading the next files overlaps simulating the last ones. Files that can not be read are skipped and listed
+ *  after the report.
+ */
+void batch(const string & pattern, const vector<option> & opts, int loaders, int simulators)
+{
+	batchRun run;
+	/* find the traces; glob sorts them by name */
+	struct stat info;
+	string expanded = (stat(pattern.c_str(), &info)==0 && S_ISDIR(info.st_mode)) ? pattern + "/*" : pattern;
+	glob_t matches;
+	if(glob(expanded.c_str(), 0, NULL, &matches)==0)
+	{
+		for(size_t i=0; i<matches.gl_pathc; i++)
+		{
+			if(stat(matches.gl_pathv[i], &info)==0 && S_ISREG(info.st_mode)) run.files.push_back(matches.gl_pathv[i]);
+		}
+	}
+	globfree(&matches);
+	if(run.files.size()==0)
+	{
+		cerr << "ERROR-- batch: '" << pattern << "' - No trace files found." << endl;
+		exit(EXIT_FAILURE);
+	}
+	/**/
+	run.nextFile = 0;
+	run.capacity = 2*simulators;
+	run.loaders = loaders;
+	run.results.resize(run.files.size());
+	run.errors.resize(run.files.size());
+	run.deadlines.resize(run.files.size());
+	vector<thread> pool;
+	for(int i=0; i<loaders; i++) pool.push_back(thread(batchLoader, ref(run)));
+	for(int i=0; i<simulators; i++) pool.push_back(thread(batchSimulator, ref(run), cref(opts)));
+	for(int i=0; i<pool.size(); i++) pool[i].join();
+	printBatchReport(run, opts);
+}
+
+/* Function:	batchLoader
+ *    Usage:	thread(batchLoader, ref(run));
+ *  -------------------------------------------
+ *  Loads the batch's files one at a time until none are left, waiting while the queue of loaded traces is full.
+ *  A file that cannot be loaded (bad lines, numbers out of range, too large to hold) is skipped with its error,
+ *  the rest of the batch still runs.
+ */
+void batchLoader(batchRun & run)
+{
+	for(int i=run.nextFile++; i<run.files.size(); i=run.nextFile++)
+	{
+		shared_ptr<workload> w(new workload());
+		string error;
+		bool loaded;
+		try
+		{
+			loaded = loadProcesses(run.files[i], w->ps, w->ioTable, error);
+		}
+		catch(const exception & e)
+		{
+			loaded = false;
+			error = run.files[i] + " - " + e.what();
+		}
+		if(!loaded) run.errors[i] = error;
+		else if(w->ps.size()==0) run.errors[i] = run.files[i] + " - The file has no processes.";
+		if(run.errors[i].length()>0) continue;
+		unique_lock<mutex> lock(run.lock);
+		while(run.loaded.size()>=run.capacity) run.spaceReady.wait(lock);
+		run.loaded.push_back(make_pair(i, shared_ptr<const workload>(w)));
+		run.traceReady.notify_one();
+	}
+	/* the last loader out wakes the simulators waiting for traces that will never come */
+	lock_guard<mutex> lock(run.lock);
+	if(--run.loaders==0) run.traceReady.notify_all();
+	/**/
+}
+
+/* Function:	batchSimulator
+ *    Usage:	thread(batchSimulator, ref(run), cref(opts));
+ *  -------------------------------------------
+ *  Simulates loaded traces under every option until the loaders are done and the queue is empty.
+ *  Only the summary of each simulation is kept, so memory does not grow with the number of traces.
+ */
+void batchSimulator(batchRun & run, const vector<option> & opts)
+{
+	while(true)
+	{
+		pair< int, shared_ptr<const workload> > trace;
+		/* wait for a trace */
+		{
+			unique_lock<mutex> lock(run.lock);
+			while(run.loaded.size()==0 && run.loaders>0) run.traceReady.wait(lock);
+			if(run.loaded.size()==0) return;
+			trace = run.loaded.front();
+			run.loaded.pop_front();
+			run.spaceReady.notify_one();
+		}
+		/**/
+		const vector<process> & ps = trace.second->ps;
+		for(int j=0; j<ps.size(); j++)
+		{
+			if(ps[j].deadline>0) run.deadlines[trace.first] = true;
+		}
+		vector<optionSummary> & results = run.results[trace.first];
+		for(int j=0; j<opts.size(); j++)
+		{
+			int totalTime;
+			int idleTime;
+			vector<processStats> pStats;
+			simulate(ps, trace.second->ioTable, opts[j], totalTime, idleTime, pStats);
+			results.push_back(summarize(pStats, totalTime, idleTime));
+		}
+	}
+}
+
+/* Function:	printBatchReport
+ *    Usage:	printBatchReport(run, opts);
+ *  -------------------------------------------
+ *  Prints out the results of a batch run, one line per trace and option in the order of the files,
+ *  followed by the files that were skipped.
+ */
+void printBatchReport(const batchRun & run, const vector<option> & opts)
+{
+	int w = 13; //static column width
+	int tw = 7; //dynamic column widths (Trace and Scheduler are the dynamic columns)
+	int ww = 13;
+	bool deadlines = false; //only report deadline misses if some process has a deadline
+	for(int i=0; i<run.files.size(); i++)
+	{
+		tw = max(tw, (int)run.files[i].length()+2);
+		deadlines = deadlines || run.deadlines[i];
+	}
+	for(int i=0; i<opts.size(); i++) ww = max(ww, (int)optionName(opts[i]).length()+2);
+	stringstream ss;
+	ss << left;
+	ss << setw(tw) << "" << setw(ww) << "" << setw(w) << "Average" << setw(w) << "Average" << setw(w) << "CPU";
+	if(deadlines) ss << setw(w) << "Deadline";
+	ss << endl;
+	ss << setw(tw) << "" << setw(ww) << "" << setw(w) << "Turnaround" << setw(w) << "CPU Waiting" << setw(w) << "Utilization";
+	if(deadlines) ss << setw(w) << "Misses";
+	ss << endl;
+	ss << setw(tw) << "Trace" << setw(ww) << "Scheduler" << setw(w) << "Time" << setw(w) << "Time" << setw(w) << "%";
+	if(deadlines) ss << setw(w) << "#";
+	ss << endl;
+	for(int i=0; i<tw+ww+w+w+w-2+(deadlines ? w : 0); i++) ss << "="; //insert a line of the appropriate length
+	ss << endl;
+	for(int i=0; i<run.files.size(); i++)
+	{
+		for(int j=0; j<run.results[i].size(); j++)
+		{
+			const optionSummary & sum = run.results[i][j];
+			ss << fixed << setprecision(2) << setw(tw) << run.files[i] << setw(ww) << optionName(opts[j]) << setw(w) << sum.avgTurnAround << setw(w) << sum.avgWaiting;
+			if(deadlines) ss << setw(w) << sum.cpuUtilization << sum.deadlineMisses << endl;
+			else ss << sum.cpuUtilization << endl;
+		}
+	}
+	cout << ss.str();
+	for(int i=0; i<run.files.size(); i++)
+	{
+		if(run.errors[i].length()>0) cerr << "ERROR-- batch: " << run.errors[i] << " (skipped)" << endl;
+	}
+}
+
+/* Function:	serve
+ *    Usage:	serve("/tmp/cpu.sock", 4);
+ *  -------------------------------------------
+ *  Runs the simulation server: workloads (processes files) are loaded once and kept in memory by name, and
+ *  clients send simulation requests over a unix domain socket. Every request and response is a JSON object on
+ *  a single line. The options of a request run concurrently on a pool of worker threads and a response is
+ *  streamed back as each one finishes, followed by a final "done" response.
+ *		{"cmd":"load", "name":"w", "path":"P.dat"}						-> {"name":"w","processes":32}
+ *		{"cmd":"unload", "name":"w"}									-> {"name":"w","unloaded":true}
+ *		{"cmd":"run", "id":"r1", "workload":"w", "options":["FCFS","RR-50/10"]}
+ *		{"cmd":"sweep", "id":"s1", "workload":"w", "alg":"RR", "params":[[50,300,500],[0,10]]}
+ *																		-> {"id":"r1","option":"RR-50/10","avgTurnaround":...}, ..., {"id":"r1","done":true,"options":2}
+ *		{"cmd":"shutdown"}
+ *  A sweep runs every combination of the values listed for each modifier of the algorithm (eg. RR-50/0 ... RR-500/10).
+ *  After a shutdown, new runs and sweeps are refused and the options already queued finish before serve returns.
+ *  Failed requests are answered with {"id":..., "error":"..."}.
+ *  - socketPath: the path of the socket to listen on; an existing file there is replaced
+ *  - workers: the number of simulations run at the same time
+ */
+void serve(string socketPath, int workers)
+{
+	signal(SIGPIPE, SIG_IGN); //a client hanging up must not end the server
+	shared_ptr<simServer> owner(new simServer()); //client threads keep their own reference, since they are not joined
+	simServer & server = *owner;
+	server.stopping = false;
+	/* listen on the socket */
+	sockaddr_un addr = sockaddr_un();
+	addr.sun_family = AF_UNIX;
+	if(socketPath.length()>=sizeof(addr.sun_path))
+	{
+		cerr << "ERROR-- serve: '" << socketPath << "' - The socket path is too long." << endl;
+		exit(EXIT_FAILURE);
+	}
+	socketPath.copy(addr.sun_path, socketPath.length());
+	unlink(socketPath.c_str());
+	server.listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(server.listenFd<0 || ::bind(server.listenFd, (sockaddr *)&addr, sizeof(addr))<0 || listen(server.listenFd, 64)<0)
+	{
+		cerr << "ERROR-- serve: '" << socketPath << "' - Unable to listen on the socket." << endl;
+		exit(EXIT_FAILURE);
+	}
+	/**/
+	vector<thread> pool;
+	for(int i=0; i<workers; i++) pool.push_back(thread(serveWorker, ref(server)));
+	/* give each client its own thread to read requests; the loop ends when a shutdown request closes the socket */
+	while(true)
+	{
+		int fd = accept(server.listenFd, NULL, NULL);
+		if(fd<0) break;
+		shared_ptr<serverConnection> conn(new serverConnection());
+		conn->fd = fd;
+		thread(serveConnection, owner, conn).detach();
+	}
+	/**/
+	/* let the workers finish the queued tasks; nothing is queued once stopping is set, so none are left behind */
+	{
+		lock_guard<mutex> lock(server.taskLock);
+		server.stopping = true;
+		close(server.listenFd);
+		server.listenFd = -1;
+	}
+	server.taskReady.notify_all();
+	for(int i=0; i<pool.size(); i++) pool[i].join();
+	unlink(socketPath.c_str());
+	/**/
+}
+
+/* Function:	serveWorker
+ *    Usage:	thread(serveWorker, ref(server));
+ *  -------------------------------------------
+ *  Runs queued simulation tasks until the server stops, sending each result to the client that requested it.
+ */
+void serveWorker(simServer & server)
+{
+	while(true)
+	{
+		simTask task;
+		/* wait for a task */
+		{
+			unique_lock<mutex> lock(server.taskLock);
+			while(server.tasks.size()==0 && !server.stopping) server.taskReady.wait(lock);
+			if(server.tasks.size()==0) return;
+			task = server.tasks.front();
+			server.tasks.pop_front();
+		}
+		/**/
+		int totalTime;
+		int idleTime;
+		vector<processStats> pStats;
+		simulate(task.w->ps, task.w->ioTable, task.opt, totalTime, idleTime, pStats);
+		optionSummary sum = summarize(pStats, totalTime, idleTime);
+		stringstream ss;
+		ss << fixed << setprecision(2) << "{\"id\":" << jsonString(task.id) << ",\"option\":" << jsonString(optionName(task.opt))
+			<< ",\"avgTurnaround\":" << sum.avgTurnAround << ",\"avgWaiting\":" << sum.avgWaiting << ",\"p99Waiting\":" << sum.p99Waiting
+			<< ",\"utilization\":" << sum.cpuUtilization << ",\"deadlineMisses\":" << sum.deadlineMisses
+			<< ",\"totalTime\":" << totalTime << ",\"idleTime\":" << idleTime << "}";
+		sendLine(*task.conn, ss.str());
+		if(--*task.remaining==0) sendLine(*task.conn, "{\"id\":" + jsonString(task.id) + ",\"done\":true,\"options\":" + to_string(task.options) + "}");
+	}
+}
+
+/* Function:	serveConnection
+ *    Usage:	thread(serveConnection, owner, conn).detach();
+ *  -------------------------------------------
+ *  Reads a client's requests, one per line, and handles each in turn until the client hangs up.
+ *  A request that fails unexpectedly is answered with an error instead of ending the server.
+ */
+void serveConnection(shared_ptr<simServer> server, shared_ptr<serverConnection> conn)
+{
+	string pending;
+	char buffer[4096];
+	while(true)
+	{
+		ssize_t n = recv(conn->fd, buffer, sizeof(buffer), 0);
+		if(n<=0) return;
+		pending.append(buffer, n);
+		size_t newline;
+		while((newline = pending.find('\n'))!=string::npos)
+		{
+			string line = pending.substr(0, newline);
+			pending.erase(0, newline+1);
+			if(line.find_first_not_of(" \t\r")==string::npos) continue;
+			try
+			{
+				handleRequest(*server, conn, line);
+			}
+			catch(const exception & e)
+			{
+				sendLine(*conn, "{\"error\":" + jsonString(string("The request failed: ") + e.what()) + "}");
+			}
+		}
+	}
+}
+
+/* Function:	handleRequest
+ *    Usage:	handleRequest(server, conn, "{\"cmd\":\"load\",\"name\":\"w\",\"path\":\"P.dat\"}");
+ *  -------------------------------------------
+ *  Handles a single request (see serve). Loads and unloads are answered right away;
+ *  the options of run and sweep requests are queued for the workers.
+ */
+void handleRequest(simServer & server, shared_ptr<serverConnection> conn, const string & line)
+{
+	jsonValue request;
+	int pos = 0;
+	if(!parseJson(line, pos, request) || request.type!='o' || request.fields.count("cmd")==0)
+	{
+		sendLine(*conn, "{\"error\":\"Each request MUST be a JSON object with a cmd on a single line.\"}");
+		return;
+	}
+	string cmd = request.fields["cmd"].text;
+	string id = request.fields.count("id") ? request.fields["id"].text : "";
+	string error;
+	if(cmd=="load")
+	{
+		string name = request.fields["name"].text;
+		shared_ptr<workload> w(new workload());
+		if(name.length()==0) error = "A load MUST name the workload.";
+		else if(!loadProcesses(request.fields["path"].text, w->ps, w->ioTable, error)) {}
+		else if(w->ps.size()==0) error = "'" + request.fields["path"].text + "' has no processes.";
+		else
+		{
+			lock_guard<mutex> lock(server.workloadLock);
+			server.workloads[name] = w;
+		}
+		if(error.length()==0) sendLine(*conn, "{\"id\":" + jsonString(id) + ",\"name\":" + jsonString(name) + ",\"processes\":" + to_string(w->ps.size()) + "}");
+	}
+	else if(cmd=="unload")
+	{
+		string name = request.fields["name"].text;
+		bool unloaded;
+		{
+			lock_guard<mutex> lock(server.workloadLock);
+			unloaded = server.workloads.erase(name)>0;
+		}
+		if(!unloaded) error = "'" + name + "' is not loaded.";
+		else sendLine(*conn, "{\"id\":" + jsonString(id) + ",\"name\":" + jsonString(name) + ",\"unloaded\":true}");
+	}
+	else if(cmd=="run" || cmd=="sweep")
+	{
+		shared_ptr<const workload> w;
+		{
+			lock_guard<mutex> lock(server.workloadLock);
+			string name = request.fields["workload"].text;
+			if(server.workloads.count(name)) w = server.workloads[name];
+			else error = "'" + name + "' is not loaded.";
+		}
+		/* collect the option lines: listed for a run, every combination of the modifiers for a sweep */
+		vector<string> lines;
+		if(cmd=="run")
+		{
+			for(int i=0; i<request.fields["options"].items.size(); i++) lines.push_back(request.fields["options"].items[i].text);
+		}
+		else
+		{
+			lines.push_back(request.fields["alg"].text);
+			jsonValue & params = request.fields["params"];
+			for(int i=0; i<params.items.size(); i++)
+			{
+				vector<string> expanded;
+				for(int j=0; j<lines.size(); j++)
+				{
+					for(int k=0; k<params.items[i].items.size(); k++)
+						expanded.push_back(lines[j] + (i==0 ? "-" : "/") + params.items[i].items[k].text);
+				}
+				lines.swap(expanded);
+			}
+		}
+		if(error.length()==0 && lines.size()==0) error = "There are no options to simulate.";
+		/**/
+		vector<option> opts(lines.size());
+		for(int i=0; i<lines.size() && error.length()==0; i++)
+		{
+			if(!parseOption(lines[i], opts[i], error)) error = "'" + lines[i] + "' - " + error;
+		}
+		/* queue the options for the workers */
+		if(error.length()==0)
+		{
+			shared_ptr< atomic<int> > remaining(new atomic<int>((int)opts.size()));
+			lock_guard<mutex> lock(server.taskLock);
+			if(server.stopping) error = "The server is shutting down.";
+			for(int i=0; i<opts.size() && !server.stopping; i++)
+			{
+				simTask task;
+				task.conn = conn;
+				task.w = w;
+				task.opt = opts[i];
+				task.id = id;
+				task.remaining = remaining;
+				task.options = (int)opts.size();
+				server.tasks.push_back(task);
+			}
+			server.taskReady.notify_all();
+		}
+		/**/
+	}
+	else if(cmd=="shutdown")
+	{
+		{
+			lock_guard<mutex> lock(server.taskLock);
+			server.stopping = true;
+		}
+		server.taskReady.notify_all();
+		sendLine(*conn, "{\"id\":" + jsonString(id) + ",\"shutdown\":true}");
+		/* wake serve from accept, unless it has already closed the socket (the fd number may have been reused since) */
+		lock_guard<mutex> lock(server.taskLock);
+		if(server.listenFd>=0) shutdown(server.listenFd, SHUT_RDWR);
+		/**/
+	}
+	else error = "'" + cmd + "' is not supported.";
+	if(error.length()>0) sendLine(*conn, "{\"id\":" + jsonString(id) + ",\"error\":" + jsonString(error) + "}");
+}
+
+/* Function:	sendLine
+ *    Usage:	sendLine(*conn, "{\"done\":true}");
+ *  -------------------------------------------
+ *  Writes a line to a client. Lines written by different threads are never interleaved.
+ */
+void sendLine(serverConnection & conn, const string & line)
+{
+	string out = line + "\n";
+	lock_guard<mutex> lock(conn.writeLock);
+	for(size_t sent=0; sent<out.length(); )
+	{
+		ssize_t n = send(conn.fd, out.data()+sent, out.length()-sent, MSG_NOSIGNAL);
+		if(n<=0) return; //the client hung up
+		sent += n;
+	}
+}
+
+/* Function:	parseJson
+ *    Usage:	jsonValue v;
+ *				int pos = 0;
+ *				if(parseJson(text, pos, v)) ...
+ *  -------------------------------------------
+ *  Parses the JSON value starting at 'pos' of 'text' into 'v' and moves 'pos' past it.
+ *  Returns false if the text is not valid JSON. Escapes other than \" \\ \/ \n \t are kept as written.
+ */
+bool parseJson(const string & text, int & pos, jsonValue & v)
+{
+	while(pos<text.length() && isspace(text[pos])) pos++;
+	if(pos>=text.length()) return false;
+	char c = text[pos];
+	if(c=='"') //string
+	{
+		v.type = 's';
+		for(pos++; pos<text.length() && text[pos]!='"'; pos++)
+		{
+			if(text[pos]=='\\' && pos+1<text.length())
+			{
+				char e = text[++pos];
+				if(e=='n') v.text += '\n';
+				else if(e=='t') v.text += '\t';
+				else if(e=='"' || e=='\\' || e=='/') v.text += e;
+				else v.text += string("\\") + e;
+			}
+			else v.text += text[pos];
+		}
+		if(pos>=text.length()) return false;
+		pos++;
+		return true;
+	}
+	if(c=='[' || c=='{') //array or object
+	{
+		v.type = (c=='[') ? 'a' : 'o';
+		char close = (c=='[') ? ']' : '}';
+		pos++;
+		while(pos<text.length() && isspace(text[pos])) pos++;
+		if(pos<text.length() && text[pos]==close)
+		{
+			pos++;
+			return true;
+		}
+		while(true)
+		{
+			jsonValue item;
+			if(v.type=='o')
+			{
+				jsonValue key;
+				if(!parseJson(text, pos, key) || key.type!='s') return false;
+				while(pos<text.length() && isspace(text[pos])) pos++;
+				if(pos>=text.length() || text[pos]!=':') return false;
+				pos++;
+				if(!parseJson(text, pos, item)) return false;
+				v.fields[key.text] = item;
+			}
+			else
+			{
+				if(!parseJson(text, pos, item)) return false;
+				v.items.push_back(item);
+			}
+			while(pos<text.length() && isspace(text[pos])) pos++;
+			if(pos<text.length() && text[pos]==',') pos++;
+			else if(pos<text.length() && text[pos]==close)
+			{
+				pos++;
+				return true;
+			}
+			else return false;
+		}
+	}
+	/* number or literal */
+	v.type = 'n';
+	for(; pos<text.length() && (isalnum(text[pos]) || text[pos]=='-' || text[pos]=='+' || text[pos]=='.'); pos++) v.text += text[pos];
+	return v.text.length()>0;
+	/**/
+}
+
+/* Function:	jsonString
+ *    Usage:	string quoted = jsonString(name);
+ *  -------------------------------------------
+ *  Returns 'text' as a quoted JSON string.
+ */
+string jsonString(const string & text)
+{
+	string quoted = "\"";
+	for(int i=0; i<text.length(); i++)
+	{
+		if(text[i]=='"' || text[i]=='\\') quoted += '\\';
+		if(text[i]=='\n') quoted += "\\n";
+		else if(text[i]=='\t') quoted += "\\t";
+		else quoted += text[i];
+	}
+	return quoted + "\"";
+}
+
+/* Function:	printReport
+ *    Usage:	printReport(opts, pStats, totalTimes, idleTimes);
+ *  -------------------------------------------
+ *  Prints out the results of multiple cpu scheduling option simulations.
  *  - opts: contains all of the simulated cpu scheduling options
  *  - pStats: a 2d vector where each row contains the processStats for each simulated cpu scheduling option
  *  - totalTimes: contains the total running time for each simulated cpu scheduling option
@@ -606,71 +3103,373 @@ void printReport(const vector<option> & opts, const vector< vector<processStats>
 	int w = 13; //static column width
 	int ww = 13; //dynamic column width (Scheduler is the dynamic column)
 	bool toLong; //is the text to long for the dynamic column
+	/* only report deadline misses if some process has a deadline */
+	bool deadlines = false;
+	for(int i=0; i<pStats.size() && !deadlines; i++)
+	{
+		for(int j=0; j<pStats[i].size() && !deadlines; j++) deadlines = pStats[i][j].deadline>0;
+	}
+	/**/
 	do 
 	{
-		ss.str("");
-		toLong = false;
-		
-		ss << left;
-		ss << setw(ww) << "" << setw(w) << "Average" << setw(w) << "Average" << setw(w) << "CPU" << endl;
-		ss << setw(ww) << "" << setw(w) << "Turnaround" << setw(w) << "CPU Waiting" << setw(w) << "Utilization" << endl;
-		ss << setw(ww) << "Scheduler" << setw(w) << "Time" << setw(w) << "Time" << setw(w) << "%" << endl;
-		for(int i=0; i<ww+w+w+w-2; i++) ss << "="; //insert a line of the appropriate length
-		ss << endl;
-		/* process the results for each scheduling option */
-		for(int i=0; i<opts.size(); i++)
+		ss.str("");
+		toLong = false;
+		
+		ss << left;
+		ss << setw(ww) << "" << setw(w) << "Average" << setw(w) << "Average" << setw(w) << "CPU";
+		if(deadlines) ss << setw(w) << "Deadline";
+		ss << endl;
+		ss << setw(ww) << "" << setw(w) << "Turnaround" << setw(w) << "CPU Waiting" << setw(w) << "Utilization";
+		if(deadlines) ss << setw(w) << "Misses";
+		ss << endl;
+		ss << setw(ww) << "Scheduler" << setw(w) << "Time" << setw(w) << "Time" << setw(w) << "%";
+		if(deadlines) ss << setw(w) << "#";
+		ss << endl;
+		for(int i=0; i<ww+w+w+w-2+(deadlines ? w : 0); i++) ss << "="; //insert a line of the appropriate length
+		ss << endl;
+		/* process the results for each scheduling option */
+		for(int i=0; i<opts.size(); i++)
+		{
+			optionSummary sum = summarize(pStats[i], totalTimes[i], idleTimes[i]);
+			string scheduler = optionName(opts[i]);
+			/*  determine if the text is to long for the dynamic column */
+			if(scheduler.length()+2>ww)
+			{
+				toLong=true;
+				break;
+			}
+			/**/
+			ss << fixed << setprecision(2) << setw(ww) << scheduler << setw(w) << sum.avgTurnAround << setw(w) << sum.avgWaiting;
+			if(deadlines) ss << setw(w) << sum.cpuUtilization << sum.deadlineMisses << endl;
+			else ss << sum.cpuUtilization << endl; 
+		}
+		/**/
+		ww++; //increase the width of the dynamic column
+	} while(toLong);
+	/* output to the console */
+	string output;
+	while(!ss.eof())
+	{
+		string temp;
+		getline(ss, temp);
+		output += (temp+"\n");
+	}
+	cout << output;
+	/**/
+}
+
+/* Function:	beginPhase
+ *    Usage:	phaseProfile phase = beginPhase("readInProcesses");
+ *				readInProcesses("P.dat", ps);
+ *				endPhase(phase, profile);
+ *  -------------------------------------------
+ *  Starts timing a phase of the run. Both clocks are monotonic and reading them costs well under a microsecond.
+ *  On Linux the resident memory high-water mark is started over (by writing 5 to /proc/self/clear_refs), so that
+ *  endPhase can read the phase's own peak; elsewhere only the growth of the process' peak can be measured.
+ */
+phaseProfile beginPhase(const string & name)
+{
+	phaseProfile phase = phaseProfile();
+	phase.name = name;
+	ofstream clearRefs("/proc/self/clear_refs");
+	clearRefs << "5";
+	clearRefs.close();
+	phase.ownPeak = !clearRefs.fail();
+	phase.memoryStart = processPeakMemory();
+	phase.cpuStart = cpuSeconds();
+	phase.wallStart = chrono::steady_clock::now();
+	return phase;
+}
+
+/* Function:	endPhase
+ *    Usage:	endPhase(phase, profile);
+ *  -------------------------------------------
+ *  Stops timing a phase, records its peak memory (see beginPhase) and appends the phase to 'profile'.
+ */
+void endPhase(phaseProfile & phase, vector<phaseProfile> & profile)
+{
+	phase.wallTime = chrono::duration<double>(chrono::steady_clock::now() - phase.wallStart).count();
+	phase.cpuTime = cpuSeconds() - phase.cpuStart;
+	long highWater = phase.ownPeak ? residentHighWater() : -1;
+	phase.ownPeak = highWater>=0;
+	phase.peakMemory = phase.ownPeak ? highWater : processPeakMemory() - phase.memoryStart;
+	profile.push_back(phase);
+}
+
+/* Function:	processPeakMemory
+ *    Usage:	long kb = processPeakMemory();
+ *  -------------------------------------------
+ *  Returns the largest resident memory of the process over its whole life so far, in kilobytes.
+ */
+long processPeakMemory()
+{
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+/* Function:	residentHighWater
+ *    Usage:	long kb = residentHighWater();
+ *  -------------------------------------------
+ *  Returns the resident memory high-water mark (VmHWM) of the process in kilobytes, which can be started over
+ *  unlike processPeakMemory, or -1 if /proc/self/status can not be read.
+ */
+long residentHighWater()
+{
+	ifstream status("/proc/self/status");
+	string line;
+	while(getline(status, line))
+	{
+		if(line.compare(0, 6, "VmHWM:")==0) return atol(line.c_str()+6);
+	}
+	return -1;
+}
+
+/* Function:	cpuSeconds
+ *    Usage:	double start = cpuSeconds();
+ *  -------------------------------------------
+ *  Returns the cpu time used so far by all threads of the process, in seconds.
+ */
+double cpuSeconds()
+{
+	timespec ts;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return ts.tv_sec + ts.tv_nsec/1e9;
+}
+
+/* Function:	printProfile
+ *    Usage:	printProfile(profile, false);
+ *  -------------------------------------------
+ *  Prints the time and memory used by each phase of the run, as a table or as JSON.
+ *  Simulation phases also show the simulated time units (ms) per wall clock second and the processes per wall clock second.
+ */
+void printProfile(const vector<phaseProfile> & profile, bool json)
+{
+	/* add up the whole run */
+	phaseProfile total = phaseProfile();
+	total.name = "Total";
+	bool ownPeaks = true; //every phase has its own peak, otherwise the column shows how much each raised the process' peak
+	for(int i=0; i<profile.size(); i++) ownPeaks = ownPeaks && profile[i].ownPeak;
+	for(int i=0; i<profile.size(); i++)
+	{
+		total.wallTime += profile[i].wallTime;
+		total.cpuTime += profile[i].cpuTime;
+		total.peakMemory = ownPeaks ? max(total.peakMemory, profile[i].peakMemory) : total.peakMemory + max(0L, profile[i].peakMemory);
+		total.simulatedTime += profile[i].simulatedTime;
+		total.jobs += profile[i].jobs;
+	}
+	vector<phaseProfile> rows(profile);
+	rows.push_back(total);
+	/**/
+	stringstream ss;
+	ss << fixed << setprecision(2);
+	if(json)
+	{
+		ss << "{\"phases\":[";
+		for(int i=0; i<rows.size(); i++)
+		{
+			double wall = max(rows[i].wallTime, 1e-9);
+			if(i>0) ss << ",";
+			ss << "{\"name\":" << jsonString(rows[i].name) << ",\"wallMs\":" << rows[i].wallTime*1000 << ",\"cpuMs\":" << rows[i].cpuTime*1000
+				<< (ownPeaks ? ",\"peakMemoryKB\":" : ",\"peakGrowthKB\":") << rows[i].peakMemory << ",\"simulatedMsPerSecond\":" << rows[i].simulatedTime/wall
+				<< ",\"jobsPerSecond\":" << rows[i].jobs/wall << "}";
+		}
+		ss << "]}" << endl;
+	}
+	else
+	{
+		int w = 15; //static column width
+		int ww = 13; //dynamic column width (Phase is the dynamic column)
+		for(int i=0; i<rows.size(); i++) ww = max(ww, (int)rows[i].name.length()+2);
+		ss << left << endl;
+		ss << setw(ww) << "" << setw(w) << "Wall" << setw(w) << "CPU" << setw(w) << "Peak" << setw(w) << "Simulated ms" << setw(w) << "Jobs" << endl;
+		ss << setw(ww) << "Phase" << setw(w) << "Time (ms)" << setw(w) << "Time (ms)" << setw(w) << (ownPeaks ? "Memory (KB)" : "Growth (KB)") << setw(w) << "per Second" << setw(w) << "per Second" << endl;
+		for(int i=0; i<ww+5*w-2; i++) ss << "="; //insert a line of the appropriate length
+		ss << endl;
+		for(int i=0; i<rows.size(); i++)
+		{
+			double wall = max(rows[i].wallTime, 1e-9);
+			ss << setw(ww) << rows[i].name << setw(w) << rows[i].wallTime*1000 << setw(w) << rows[i].cpuTime*1000 << setw(w) << rows[i].peakMemory;
+			if(rows[i].jobs>0) ss << setw(w) << rows[i].simulatedTime/wall << rows[i].jobs/wall;
+			ss << endl;
+		}
+	}
+	cout << ss.str();
+}
+
+/* Function:	readInProcesses
+ *    Usage:	vector<process> ps;
+ *				vector<int> ioTable;
+				readInProcess("P.dat", ps, ioTable);
+ *  -------------------------------------------
+ *  Saves the data in a formatted file (eg. "P.dat") into a vector of processes (eg. ps), and the i/o bursts
+ *  of the processes that do i/o into 'ioTable' (see workload).
+ *  Each line of the file must contain two numbers separated by a space, optionally followed by a third:
+ * 		- The first number is the arrival time (in milliseconds),
+ *		- The second number is the amount of time the process requires to complete (in milliseconds)
+ *		  or, for a process that does i/o, its cpu and i/o bursts alternating, separated by commas (eg. 20,100,15)
+ *		- The optional third number is the nice value (-20 to 19, default 0) used to weight the process under CFS
+ *		- The optional fourth number is the deadline, the time after arrival by which the process should finish (in milliseconds)
+ *		eg. "30 2000" "30 2000 -5" "30 2000 0 5000" "30 20,100,15,50,10"
+ */
+void readInProcesses(string filename, vector<process> & ps, vector<int> & ioTable)
+{
+	string error;
+	if(!loadProcesses(filename, ps, ioTable, error))
+	{
+		cerr << "ERROR-- readInProcesses: " << error << endl;
+		exit(EXIT_FAILURE);
+	}
+}
+
+/* Function:	parseProcess
+ *    Usage:	process pr;
+ *				string error;
+ *				if(parseProcess("30 2000", pr, ioTable, error)) ...
+ *  -------------------------------------------
+ *  Saves a single line of a processes file (see readInProcesses) into 'pr', appending its i/o bursts to 'ioTable'.
+ *  Returns false and sets 'error' to describe the problem if the line is malformed.
+ */
+bool parseProcess(const string & line, process & pr, vector<int> & ioTable, string & error)
+{
+	int end = 0; //holds the current position in the line
+	/* skip whitespace */
+	while(isblank(line[end])) end++;
+	/**/
+	/* if a number doesnt come next, error */
+	if(!isdigit(line[end])) 
+	{
+		error = "Each line MUST contain two positive numbers separated by a single space.";
+		return false;
+	}
+	/**/
+	/* save the arrival time */
+	for(; end<line.length() && isdigit(line[end]); end++) {}
+	if(!parseInt(line.substr(0,end), pr.arrival, error)) return false;
+	/**/
+	/* skip whitespace */
+	while(isblank(line[end])) end++;
+	/**/
+	/* if a number doesnt come next, error */
+	if(!isdigit(line[end]))
+	{
+		error = "Each line MUST contain two positive numbers separated by a single space.";
+		return false;
+	}
+	/**/
+	/* save the burst time */
+	int firstDigit = end;
+	for(; end<line.length() && isdigit(line[end]); end++) {}
+	if(!parseInt(line.substr(firstDigit, end-firstDigit), pr.burst, error)) return false;
+
+	if(pr.burst==0) //error if the burst is 0
+	{
+		error = "Ensure that all process burst times are > 0.";
+		return false;
+	}
+	/**/
+	/* save the optional i/o and cpu bursts that follow, separated by commas */
+	pr.io = 0;
+	if(end<line.length() && line[end]==',')
+	{
+		vector<int> io;
+		while(end<line.length() && line[end]==',')
 		{
-			int totalTurnAround=0;
-			int totalWaiting=0;
-			for(int j = 0; j<pStats[i].size(); j++)
-			{
-				totalTurnAround += pStats[i][j].turnAround;
-				totalWaiting += pStats[i][j].waiting;
-			}
-			double avgTurnAround = (double)totalTurnAround/pStats[i].size();
-			double avgWaiting = (double)totalWaiting/pStats[i].size();
-			double cpuUtilization = ( (totalTimes[i]-idleTimes[i])/(double)totalTimes[i] ) * 100;
-
-			string scheduler = ALGORITHM[opts[i].alg];
-			if(opts[i].alg==RR) scheduler += "-" + to_string(opts[i].slice) + "/" + to_string(opts[i].switchTime);
-			if(opts[i].alg==RRP) scheduler += "-" + to_string(opts[i].slice) + "/" + to_string(opts[i].prioritySlice) + "/" + to_string(opts[i].switchTime);
-			/*  determine if the text is to long for the dynamic column */
-			if(scheduler.length()+2>ww)
+			end++;
+			firstDigit = end;
+			for(; end<line.length() && isdigit(line[end]); end++) {}
+			int burst = 0;
+			if(end>firstDigit && !parseInt(line.substr(firstDigit, end-firstDigit), burst, error)) return false;
+			if(burst==0) //error if a burst is missing or 0
 			{
-				toLong=true;
-				break;
+				error = "Ensure that all process burst times are > 0.";
+				return false;
 			}
-			/**/
-			ss << fixed << setprecision(2) << setw(ww) << scheduler << setw(w) << avgTurnAround << setw(w) << avgWaiting << cpuUtilization << endl; 
+			io.push_back(burst);
+		}
+		if(io.size()%2!=0) //error if the process ends with an i/o burst
+		{
+			error = "A process' bursts MUST alternate cpu and i/o, starting and ending with a cpu burst.";
+			return false;
+		}
+		if(ioTable.size()+io.size()+2 > INT_MAX) //error if the bursts can not be indexed
+		{
+			error = "The processes have too many i/o bursts.";
+			return false;
+		}
+		if(ioTable.size()==0) ioTable.push_back(0); //index 0 means no i/o
+		pr.io = (int)ioTable.size();
+		ioTable.insert(ioTable.end(), io.begin(), io.end());
+		ioTable.push_back(0);
+	}
+	/**/
+	/* skip whitespace */
+	while(isblank(line[end])) end++;
+	/**/
+	/* save the optional nice value */
+	pr.nice = 0;
+	if(end<line.length() && (line[end]=='-' || isdigit(line[end])))
+	{
+		int firstChar = end;
+		if(line[end]=='-') end++;
+		for(; end<line.length() && isdigit(line[end]); end++) {}
+		if(end==firstChar+1 && line[firstChar]=='-')
+		{
+			error = "A nice value MUST be a number.";
+			return false;
+		}
+		if(!parseInt(line.substr(firstChar, end-firstChar), pr.nice, error)) return false;
+		if(pr.nice<-20 || pr.nice>19) //error if the nice value is out of range
+		{
+			error = "Ensure that all nice values are between -20 and 19.";
+			return false;
 		}
+		/* skip whitespace */
+		while(isblank(line[end])) end++;
 		/**/
-		ww++; //increase the width of the dynamic column
-	} while(toLong);
-	/* output to the console */
-	string output;
-	while(!ss.eof())
+	}
+	/**/
+	/* save the optional deadline */
+	pr.deadline = 0;
+	if(end<line.length() && isdigit(line[end]))
 	{
-		string temp;
-		getline(ss, temp);
-		output += (temp+"\n");
+		int firstDigit = end;
+		for(; end<line.length() && isdigit(line[end]); end++) {}
+		if(!parseInt(line.substr(firstDigit, end-firstDigit), pr.deadline, error)) return false;
+		if(pr.deadline==0) //error if the deadline is 0
+		{
+			error = "Ensure that all process deadlines are > 0.";
+			return false;
+		}
+		/* skip whitespace */
+		while(isblank(line[end])) end++;
+		/**/
+	}
+	/**/
+	/* if a something comes next, error */
+	if(end<line.length() && isprint(line[end]))
+	{
+		error = "Each line MUST only contain two numbers, an optional nice value and an optional deadline separated by single spaces. No lagging spaces.";
+		return false;
 	}
-	cout << output;
 	/**/
+	return true;
 }
 
-/* Function:	readInProcesses
+/* Function:	loadProcesses
  *    Usage:	vector<process> ps;
-				readInProcess("P.dat", ps);
+ *				vector<int> ioTable;
+ *				string error;
+ *				if(!loadProcesses("P.dat", ps, ioTable, error)) ...
  *  -------------------------------------------
- *  Saves the data in a formatted file (eg. "P.dat") into a vector of processes (eg. ps).
- *  Each line of the file must contain two numbers separated by a space:
- * 		- The first number is the arrival time (in milliseconds),
- *		- The second number is the amount of time the process requires to complete (in milliseconds)
- *		eg. "30 2000"
+ *  Saves the processes in a formatted file (see readInProcesses) into 'ps', sorted by arrival time,
+ *  and their i/o bursts into 'ioTable'.
+ *  Returns false and sets 'error' to describe the first malformed line instead of exiting.
  */
-void readInProcesses(string filename, vector<process> & ps)
+bool loadProcesses(string filename, vector<process> & ps, vector<int> & ioTable, string & error)
 {
 	ps.clear();
+	ioTable.clear();
 	ifstream p(filename, fstream::in);
 	string line;
 	while(p.good())
@@ -678,57 +3477,17 @@ void readInProcesses(string filename, vector<process> & ps)
 		getline(p, line);
 		if(line.length()>0 && isprint(line[0]))
 		{
-			int end = 0; //holds the current position in the line
 			process pr; //holds the input
-			/* skip whitespace */
-			while(isblank(line[end])) end++;
-			/**/
-			/* if a number doesnt come next, error */
-			if(!isdigit(line[end])) 
-			{
-				cerr << "ERROR-- readInProcesses: " << filename << " '"<< line << "' - Each line MUST contain two positive numbers separated by a single space." << endl;
-				exit(EXIT_FAILURE);
-			}
-			/**/
-			/* save the arrival time */
-			for(; end<line.length() && isdigit(line[end]); end++) {}
-			pr.arrival = stoi(line.substr(0,end));
-			/**/
-			/* skip whitespace */
-			while(isblank(line[end])) end++;
-			/**/
-			/* if a number doesnt come next, error */
-			if(!isdigit(line[end]))
-			{
-				cerr << "ERROR-- readInProcesses: " << filename << " '"<< line << "' - Each line MUST contain two positive numbers separated by a single space." << endl;
-				exit(EXIT_FAILURE);
-			}
-			/**/
-			/* save the burst time */
-			int firstDigit = end;
-			for(; end<line.length() && isdigit(line[end]); end++) {}
-			pr.burst = stoi(line.substr(firstDigit, end-firstDigit+1));
-	
-			if(pr.burst==0) //error if the burst is 0
-			{
-				cerr << "ERROR-- readInProcesses: " << filename << " '"<< line << "' - Ensure that all process burst times are > 0." << endl;
-				exit(EXIT_FAILURE);
-			}
-			/**/
-			/* skip whitespace */
-			while(isblank(line[end])) end++;
-			/**/
-			/* if a something comes next, error */
-			if(end<line.length() && isprint(line[end]))
+			if(!parseProcess(line, pr, ioTable, error))
 			{
-				cerr << "ERROR-- readInProcesses: " << filename << " '"<< line << "' - Each line MUST only contain two numbers separated by a single space. No lagging spaces." << endl;
-				exit(EXIT_FAILURE);
+				error = filename + " '" + line + "' - " + error;
+				return false;
 			}
-			/**/
 			addProcessByArrival(pr, ps);
 		}
 	}
 	p.close();
+	return true;
 }
 
 /* Function:	readInOptions
@@ -737,11 +3496,15 @@ void readInProcesses(string filename, vector<process> & ps)
  *  -------------------------------------------
  *  Saves the data from a properly formatted file (eg. "S.dat") into a vector of cpu scheduling options (eg. opts).
  *  Each line of the file must contain the algorithm identifier, followed by an optional integer pair lead with a dash:
- * 		- The algorithm identifier must be one of the following: FCFS, PSJF, NPSJF, RR, RRP
+ * 		- The algorithm identifier must be one of the following: FCFS, PSJF, NPSJF, RR, RRP, CFS, MLFQ, EDF
  *		- If RR, the integer pair represents the Time Slice (S) and the Context Switching Time (T). (eg. S/T)
  *		- If RRP, the integer pair represents the Time Slice (S), the Priority Time Slice (PS) 
 		  and the Context Switching Time (T). (eg. S/PS/T) 	 
- *		eg. "FCFS" "RR-100/10" "RRP-100/1000/10"
+ *		- If CFS, the integers represent the Scheduling Latency (L), the Minimum Granularity (G)
+		  and the Context Switching Time (T). (eg. L/G/T)
+ *		- If MLFQ, the integers represent the number of priority Levels (L), the top level Time Slice (S),
+		  the priority Boost Period (B, 0 for none) and the Context Switching Time (T). (eg. L/S/B/T)
+ *		eg. "FCFS" "RR-100/10" "RRP-100/1000/10" "CFS-24/3/10" "MLFQ-4/50/5000/10"
  */
 void readInOptions(string filename, vector<option> & opts)
 {
@@ -753,151 +3516,381 @@ void readInOptions(string filename, vector<option> & opts)
 		getline(s, line);
 		if(line.length()>0 && isprint(line[0]))
 		{
-			int end = 0; //holds the current position in the line
 			option opt; //holds the input
-			/* skip whitespace */
-			while(isblank(line[end])) end++;
-			/**/
-			/* if a letter doesnt come next, error */
-			if(!isalpha(line[end]))
+			string error;
+			if(!parseOption(line, opt, error))
 			{
-				cerr << "ERROR-- readInOptions: " << filename << " '"<< line << "' - Each line MUST start with a letter." << endl;
+				cerr << "ERROR-- readInOptions: " << filename << " '"<< line << "' - " << error << endl;
 				exit(EXIT_FAILURE);
 			}
+			opts.push_back(opt);
+		}
+	}
+	s.close();
+}
+
+/* Function:	parseOption
+ *    Usage:	option opt;
+ *				string error;
+ *				if(parseOption("RR-100/10", opt, error)) ...
+ *  -------------------------------------------
+ *  Saves a single line of a cpu scheduling options file (see readInOptions) into 'opt'.
+ *  Returns false and sets 'error' to describe the problem if the line is malformed.
+ */
+bool parseOption(const string & line, option & opt, string & error)
+{
+	int end = 0; //holds the current position in the line
+	opt = option();
+	/* skip whitespace */
+	while(isblank(line[end])) end++;
+	/**/
+	/* if a letter doesnt come next, error */
+	if(!isalpha(line[end]))
+	{
+		error = "Each line MUST start with a letter.";
+		return false;
+	}
+	/**/
+	/* save the option */
+	int start = end;
+	for(; end<line.length() && isalpha(line[end]); end++) {}
+	string prospect = line.substr(start,end-start);
+	for(int i=0; i<NUM_ALGORITHMS; i++)
+	{
+		if(prospect==ALGORITHM[i]) 
+		{
+			opt.alg = (algorithm)i;
+			break;
+		}
+		else if(i==NUM_ALGORITHMS-1)
+		{
+			error = "'" + prospect + "' is not supported.";
+			return false;
+		}
+	}
+	/**/
+	/* skip whitespace */
+	while(isblank(line[end])) end++;
+	/**/
+	/* if RR or RRP and a dash comes next, read in the integer pair*/
+	if((opt.alg==RR || opt.alg==RRP) && end<line.length() && line[end] == '-')
+	{
+		end++;
+		/* skip whitespace */
+		while(isblank(line[end])) end++;
+		/**/
+		/* if a number doesnt come next, error */
+		if(!isdigit(line[end]))
+		{
+			error = "Each dash MUST be followed by a number.";
+			return false;
+		}
+		/**/
+		/* save the slice  */
+		int firstDigit = end;
+		for(; end<line.length() && isdigit(line[end]); end++) {}
+		if(!parseInt(line.substr(firstDigit, end-firstDigit), opt.slice, error)) return false;
+		if(opt.slice==0) // error if the slice is 0
+		{
+			error = "Ensure that all RR and RRP time slices are > 0.";
+			return false;
+		}
+		/**/
+		/* skip whitespace */
+		while(isblank(line[end])) end++;
+		/**/
+		/* if a slash and a number dont come next, error */
+		int slashLoc = end++;
+		/* skip whitespace */
+		while(isblank(line[end])) end++;
+		/**/
+		if(line[slashLoc]!='/' || !isdigit(line[end]))
+		{
+			if(opt.alg==RR) error = "For RR, there MUST be two numbers each separated by a slash ( TimeSlice/ContextSwitchTime )";
+			else if(opt.alg==RRP) error = "For RRP, there MUST be three numbers each separated by a slash ( TimeSlice/PriorityTimeSlice/ContextSwitchTime )";
+			return false;
+		}
+		if(opt.alg==RR)
+		{
 			/**/
-			/* save the option */
-			int start = end;
-			for(; end<line.length() && isalpha(line[end]); end++) {}
-			string prospect = line.substr(start,end-start);
-			for(int i=0; i<NUM_ALGORITHMS; i++)
-			{
-				if(prospect==ALGORITHM[i]) 
-				{
-					opt.alg = (algorithm)i;
-					break;
-				}
-				else if(i==NUM_ALGORITHMS-1)
-				{
-					cerr << "ERROR-- readInOptions: " << filename << " - '"<< prospect << "' is not supported." << endl;
-					exit(EXIT_FAILURE);
-				}
-			}
+			/* save the switch time */
+			firstDigit = end;
+			for(; end<line.length() && isdigit(line[end]); end++) {}
+			if(!parseInt(line.substr(firstDigit, end-firstDigit), opt.switchTime, error)) return false;
 			/**/
 			/* skip whitespace */
 			while(isblank(line[end])) end++;
 			/**/
-			/* if RR or RRP and a dash comes next, read in the integer pair*/
-			if((opt.alg==RR || opt.alg==RRP) && end<line.length() && line[end] == '-')
+			/* if a something comes next, error */
+			if(end<line.length() && isprint(line[end]))
 			{
-				end++;
-				/* skip whitespace */
-				while(isblank(line[end])) end++;
-				/**/
-				/* if a number doesnt come next, error */
-				if(!isdigit(line[end]))
-				{
-					cerr << "ERROR-- readInOptions: " << filename << " '"<< line << "' - Each dash MUST be followed by a number." << endl;
-					exit(EXIT_FAILURE);
-				}
-				/**/
-				/* save the slice  */
-				int firstDigit = end;
-				for(; end<line.length() && isdigit(line[end]); end++) {}
-				opt.slice = stoi(line.substr(firstDigit, end-firstDigit+1));
-				if(opt.slice==0) // error if the slice is 0
-				{
-					cerr << "ERROR-- readInOptions: " << filename << " '"<< line << "' - Ensure that all RR and RRP time slices are > 0." << endl;
-					exit(EXIT_FAILURE);
-				}
-				/**/
-				/* skip whitespace */
-				while(isblank(line[end])) end++;
-				/**/
-				/* if a slash and a number dont come next, error */
-				int slashLoc = end++;
-				/* skip whitespace */
-				while(isblank(line[end])) end++;
-				/**/
-				if(line[slashLoc]!='/' || !isdigit(line[end]))
-				{
-					if(opt.alg==RR) cerr << "ERROR-- readInOptions: " << filename << " '"<< line << "' - For RR, there MUST be two numbers each separated by a slash ( TimeSlice/ContextSwitchTime )" << endl;
-					else if(opt.alg==RRP) cerr << "ERROR-- readInOptions: " << filename << " '"<< line << "' - For RRP, there MUST be three numbers each separated by a slash ( TimeSlice/PriorityTimeSlice/ContextSwitchTime )" << endl;
-					exit(EXIT_FAILURE);
-				}
-				if(opt.alg==RR)
-				{
-					/**/
-					/* save the switch time */
-					firstDigit = end;
-					for(; end<line.length() && isdigit(line[end]); end++) {}
-					opt.switchTime = stoi(line.substr(firstDigit, end-firstDigit+1));
-					/**/
-					/* skip whitespace */
-					while(isblank(line[end])) end++;
-					/**/
-					/* if a something comes next, error */
-					if(end<line.length() && isprint(line[end]))
-					{
-						cerr << "ERROR-- readInOptions: " << filename << " '"<< line << "' - For RR, there MUST only be two numbers each separated by a slash ( TimeSlice/ContextSwitchTime )" << endl;
-						exit(EXIT_FAILURE);
-					}
-					/**/
-				}
-				else if(opt.alg==RRP)
-				{
-					/**/
-					/* save the priority slice */
-					firstDigit = end;
-					for(; end<line.length() && isdigit(line[end]); end++) {}
-					opt.prioritySlice = stoi(line.substr(firstDigit, end-firstDigit+1));
-					/**/
-					/* skip whitespace */
-					while(isblank(line[end])) end++;
-					/**/
-					/* if a slash and a number dont come next, error */
-					slashLoc = end++;
-					/* skip whitespace */
-					while(isblank(line[end])) end++;
-					/**/
-					if(line[slashLoc]!='/' || !isdigit(line[end]))
-					{
-						cerr << "ERROR-- readInOptions: " << filename << " '"<< line << "' - For RRP, there MUST be three numbers each separated by a slash ( TimeSlice/PriorityTimeSlice/ContextSwitchTime )" << endl;
-						exit(EXIT_FAILURE);
-					}
-					/**/
-					/* save the switch time */
-					firstDigit = end;
-					for(; end<line.length() && isdigit(line[end]); end++) {}
-					opt.switchTime = stoi(line.substr(firstDigit, end-firstDigit+1));
-					/**/
-					/* skip whitespace */
-					while(isblank(line[end])) end++;
-					/**/
-					/* if a something comes next, error */
-					if(end<line.length() && isprint(line[end]))
-					{
-						cerr << "ERROR-- readInOptions: " << filename << " '"<< line << "' - For RRP, there MUST only be three numbers each separated by a slash ( TimeSlice/PriorityTimeSlice/ContextSwitchTime )" << endl;
-						exit(EXIT_FAILURE);
-					}
-					/**/
-				}
+				error = "For RR, there MUST only be two numbers each separated by a slash ( TimeSlice/ContextSwitchTime )";
+				return false;
 			}
-			/* if nothing come next, save the default integer pair*/
-			else if(opt.alg!=RR && opt.alg!=RRP && (end>=line.length() || !isprint(line[end])))
+			/**/
+		}
+		else if(opt.alg==RRP)
+		{
+			/**/
+			/* save the priority slice */
+			firstDigit = end;
+			for(; end<line.length() && isdigit(line[end]); end++) {}
+			if(!parseInt(line.substr(firstDigit, end-firstDigit), opt.prioritySlice, error)) return false;
+			/**/
+			/* skip whitespace */
+			while(isblank(line[end])) end++;
+			/**/
+			/* if a slash and a number dont come next, error */
+			slashLoc = end++;
+			/* skip whitespace */
+			while(isblank(line[end])) end++;
+			/**/
+			if(line[slashLoc]!='/' || !isdigit(line[end]))
 			{
-				opt.slice = 0;
-				opt.switchTime = 0;
+				error = "For RRP, there MUST be three numbers each separated by a slash ( TimeSlice/PriorityTimeSlice/ContextSwitchTime )";
+				return false;
 			}
 			/**/
-			else
+			/* save the switch time */
+			firstDigit = end;
+			for(; end<line.length() && isdigit(line[end]); end++) {}
+			if(!parseInt(line.substr(firstDigit, end-firstDigit), opt.switchTime, error)) return false;
+			/**/
+			/* skip whitespace */
+			while(isblank(line[end])) end++;
+			/**/
+			/* if a something comes next, error */
+			if(end<line.length() && isprint(line[end]))
 			{
-				if(line[end]=='-') cerr << "ERROR-- readInOptions: " << filename << " '"<< line << "' - Only RR and RRP support '-' modifiers." << endl;
-				else if(opt.alg==RR || opt.alg==RRP) cerr << "ERROR-- readInOptions: " << filename << " '"<< line << "' - RR and RRP must be followed by a dash and the appropriate modifiers (eg. RR-TimeSlice/ContextSwitchTime , RRP-TimeSlice/PriorityTimeSlice/ContextSwitchTime)." << endl;
-				else cerr << "ERROR-- readInOptions: S.dat '"<< line << "' - Ensure that each line ONLY contains a single valid entry." << endl;
-				exit(EXIT_FAILURE);
+				error = "For RRP, there MUST only be three numbers each separated by a slash ( TimeSlice/PriorityTimeSlice/ContextSwitchTime )";
+				return false;
 			}
-			opts.push_back(opt);
+			/**/
 		}
 	}
-	s.close();
-}
\ No newline at end of file
+	/* if CFS and a dash comes next, read in the modifiers */
+	else if(opt.alg==CFS && end<line.length() && line[end] == '-')
+	{
+		vector<int> values;
+		if(!readInModifiers(line, end+1, values) || values.size()!=3)
+		{
+			error = "For CFS, there MUST be three numbers each separated by a slash ( SchedLatency/MinGranularity/ContextSwitchTime )";
+			return false;
+		}
+		if(values[0]==0 || values[1]==0) // error if the latency or granularity is 0
+		{
+			error = "Ensure that all CFS latencies and granularities are > 0.";
+			return false;
+		}
+		opt.latency = values[0];
+		opt.granularity = values[1];
+		opt.switchTime = values[2];
+	}
+	/**/
+	/* if MLFQ and a dash comes next, read in the modifiers */
+	else if(opt.alg==MLFQ && end<line.length() && line[end] == '-')
+	{
+		vector<int> values;
+		if(!readInModifiers(line, end+1, values) || values.size()!=4)
+		{
+			error = "For MLFQ, there MUST be four numbers each separated by a slash ( Levels/TimeSlice/BoostPeriod/ContextSwitchTime )";
+			return false;
+		}
+		if(values[0]==0 || values[0]>MAX_MLFQ_LEVELS || values[1]==0) // error if there are no levels, too many levels or the slice is 0
+		{
+			error = "Ensure that all MLFQ levels are between 1 and " + to_string(MAX_MLFQ_LEVELS) + " and all MLFQ time slices are > 0.";
+			return false;
+		}
+		opt.levels = values[0];
+		opt.slice = values[1];
+		opt.boostPeriod = values[2];
+		opt.switchTime = values[3];
+	}
+	/**/
+	/* if nothing come next, save the default integer pair*/
+	else if(opt.alg!=RR && opt.alg!=RRP && opt.alg!=CFS && opt.alg!=MLFQ && (end>=line.length() || !isprint(line[end])))
+	{
+		opt.slice = 0;
+		opt.switchTime = 0;
+	}
+	/**/
+	else
+	{
+		if(line[end]=='-') error = "Only RR, RRP, CFS and MLFQ support '-' modifiers.";
+		else if(opt.alg==RR || opt.alg==RRP || opt.alg==CFS || opt.alg==MLFQ) error = "RR, RRP, CFS and MLFQ must be followed by a dash and the appropriate modifiers (eg. RR-TimeSlice/ContextSwitchTime , RRP-TimeSlice/PriorityTimeSlice/ContextSwitchTime , CFS-SchedLatency/MinGranularity/ContextSwitchTime , MLFQ-Levels/TimeSlice/BoostPeriod/ContextSwitchTime).";
+		else error = "Ensure that each line ONLY contains a single valid entry.";
+		return false;
+	}
+	return true;
+}
+
+/* Function:	readInOptimizer
+ *    Usage:	optimizer o;
+				readInOptimizer(argc, argv, ps, ioTable, o);
+ *  -------------------------------------------
+ *  Initializes the slice optimizer from the command line:
+ *		Cpu --optimize ALGORITHM SWITCHTIME OBJECTIVE [FLOOR]
+ * 		- ALGORITHM must be RR or RRP
+ *		- SWITCHTIME is the Context Switching Time every candidate is simulated with
+ *		- OBJECTIVE must be one of: turnaround (average turnaround time), p99wait (99th percentile waiting time),
+ *		  utilization (average turnaround time among options whose cpu utilization % is at least FLOOR)
+ *		eg. "Cpu --optimize RR 10 turnaround" "Cpu --optimize RRP 10 utilization 95"
+ */
+void readInOptimizer(int argc, char *argv[], const vector<process> & ps, const vector<int> & ioTable, optimizer & o)
+{
+	if(argc<5)
+	{
+		cerr << "ERROR-- readInOptimizer: usage: " << argv[0] << " --optimize RR|RRP SwitchTime turnaround|p99wait|utilization [Floor]" << endl;
+		exit(EXIT_FAILURE);
+	}
+	string alg = argv[2];
+	if(alg=="RR") o.alg = RR;
+	else if(alg=="RRP") o.alg = RRP;
+	else
+	{
+		cerr << "ERROR-- readInOptimizer: '" << alg << "' - Only RR and RRP have slice parameters to optimize." << endl;
+		exit(EXIT_FAILURE);
+	}
+	string switchTime = argv[3];
+	if(switchTime.length()==0 || switchTime.find_first_not_of("0123456789")!=string::npos)
+	{
+		cerr << "ERROR-- readInOptimizer: '" << switchTime << "' - The context switch time MUST be a positive number." << endl;
+		exit(EXIT_FAILURE);
+	}
+	string error;
+	if(!parseInt(switchTime, o.switchTime, error))
+	{
+		cerr << "ERROR-- readInOptimizer: " << error << endl;
+		exit(EXIT_FAILURE);
+	}
+	string goal = argv[4];
+	o.utilizationFloor = 0;
+	if(goal=="turnaround") o.goal = TURNAROUND;
+	else if(goal=="p99wait") o.goal = P99WAITING;
+	else if(goal=="utilization")
+	{
+		o.goal = UTILIZATION;
+		if(argc<6)
+		{
+			cerr << "ERROR-- readInOptimizer: The utilization objective MUST be followed by a floor (eg. 95)." << endl;
+			exit(EXIT_FAILURE);
+		}
+		char * end;
+		o.utilizationFloor = strtod(argv[5], &end);
+		if(end==argv[5] || *end!='\0' || o.utilizationFloor<0 || o.utilizationFloor>100)
+		{
+			cerr << "ERROR-- readInOptimizer: '" << argv[5] << "' - The utilization floor MUST be a number from 0 to 100." << endl;
+			exit(EXIT_FAILURE);
+		}
+	}
+	else
+	{
+		cerr << "ERROR-- readInOptimizer: '" << goal << "' - The objective MUST be one of turnaround, p99wait, utilization." << endl;
+		exit(EXIT_FAILURE);
+	}
+	o.maxSlice = 1;
+	for(int i=0; i<ps.size(); i++)
+	{
+		o.maxSlice = max(o.maxSlice, ps[i].burst);
+		for(int j=ps[i].io; j>0 && ioTable[j]>0; j+=2) o.maxSlice = max(o.maxSlice, ioTable[j+1]);
+	}
+	o.simulations = 0;
+}
+
+/* Function:	readInModifiers
+ *    Usage:	vector<int> values;
+				if(readInModifiers(line, dashLoc+1, values)) ...
+ *  -------------------------------------------
+ *  Saves the slash separated numbers that follow an algorithm identifier's dash (eg. "24/3/10") into 'values',
+ *  starting at position 'end' of 'line'. Whitespace is allowed around the numbers and slashes.
+ *  Returns false if the rest of the line is not one or more numbers separated by slashes, or a number is too large.
+ */
+bool readInModifiers(const string & line, int end, vector<int> & values)
+{
+	values.clear();
+	while(true)
+	{
+		/* skip whitespace */
+		while(isblank(line[end])) end++;
+		/**/
+		/* save the next number */
+		if(!isdigit(line[end])) return false;
+		int firstDigit = end;
+		for(; end<line.length() && isdigit(line[end]); end++) {}
+		int value;
+		string error;
+		if(!parseInt(line.substr(firstDigit, end-firstDigit), value, error)) return false;
+		values.push_back(value);
+		/**/
+		/* skip whitespace */
+		while(isblank(line[end])) end++;
+		/**/
+		/* a slash means another number comes next */
+		if(end<line.length() && line[end]=='/') end++;
+		else break;
+		/**/
+	}
+	return end>=line.length() || !isprint(line[end]);
+}
+
+/* Function:	readInSteady
+ *    Usage:	steadySettings settings;
+				readInSteady(argc, argv, settings);
+ *  -------------------------------------------
+ *  Initializes the steady state settings from the command line:
+ *		Cpu --steady MEANINTERARRIVAL MEANBURST TOLERANCE [SEED [MAXPROCESSES]]
+ *		- MEANINTERARRIVAL and MEANBURST are the means of the exponentially distributed interarrival and burst times
+ *		- TOLERANCE is the largest accepted confidence interval half width as a fraction of the mean (eg. 0.05)
+ *		- SEED (default 1) selects the random workload, MAXPROCESSES (default 1048576) caps the run length
+ *		eg. "Cpu --steady 100 80 0.05"
+ */
+void readInSteady(int argc, char *argv[], steadySettings & settings)
+{
+	if(argc<5)
+	{
+		cerr << "ERROR-- readInSteady: usage: " << argv[0] << " --steady MeanInterarrival MeanBurst Tolerance [Seed [MaxProcesses]]" << endl;
+		exit(EXIT_FAILURE);
+	}
+	settings.meanInterarrival = atof(argv[2]);
+	settings.meanBurst = atof(argv[3]);
+	settings.tolerance = atof(argv[4]);
+	settings.seed = (argc>5) ? (unsigned int)strtoul(argv[5], NULL, 10) : 1;
+	settings.maxJobs = (argc>6) ? atoi(argv[6]) : 1<<20;
+	if(settings.meanInterarrival<=0 || settings.meanBurst<=0 || settings.tolerance<=0 || settings.maxJobs<1000)
+	{
+		cerr << "ERROR-- readInSteady: Ensure that the means and tolerance are > 0 and at least 1000 processes are allowed." << endl;
+		exit(EXIT_FAILURE);
+	}
+	if(settings.meanBurst>=settings.meanInterarrival)
+	{
+		cerr << "ERROR-- readInSteady: The mean burst MUST be shorter than the mean interarrival time, or there is no steady state." << endl;
+		exit(EXIT_FAILURE);
+	}
+}
+
+/* Function:	parseInt
+ *    Usage:	string error;
+ *				if(!parseInt(line.substr(firstDigit, end-firstDigit), pr.burst, error)) return false;
+ *  -------------------------------------------
+ *  Saves the number at the start of 'text' (digits, optionally lead by a '-') into 'value'.
+ *  Returns false and sets 'error' if there is no number or it does not fit in an int, so that input
+ *  files and server requests with oversized numbers are rejected instead of throwing.
+ */
+bool parseInt(const string & text, int & value, string & error)
+{
+	char * end;
+	errno = 0;
+	long n = strtol(text.c_str(), &end, 10);
+	if(end==text.c_str())
+	{
+		error = "'" + text + "' - A number was expected.";
+		return false;
+	}
+	if(errno==ERANGE || n<INT_MIN || n>INT_MAX)
+	{
+		error = "'" + text + "' - Ensure that all numbers are at most " + to_string(INT_MAX) + ".";
+		return false;
+	}
+	value = (int)n;
+	return true;
+}